@@ -682,6 +682,10 @@ ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
         else
             QUANTUM_LIB_SRC += serial_protocol.c
             QUANTUM_LIB_SRC += serial_$(strip $(SERIAL_DRIVER)).c
+            ifeq ($(strip $(SERIAL_PIPELINE_ENABLE)), yes)
+                OPT_DEFS += -DSERIAL_PIPELINE_ENABLE
+                QUANTUM_LIB_SRC += serial_pipeline.c
+            endif
         endif
     endif
     COMMON_VPATH += $(QUANTUM_PATH)/split_common
@@ -949,6 +953,12 @@ ifeq ($(strip $(ANALOG_DRIVER_REQUIRED)), yes)
     QUANTUM_LIB_SRC += analog.c
 endif
 
+ifeq ($(strip $(I2C_ASYNC_ENABLE)), yes)
+    I2C_DRIVER_REQUIRED = yes
+    OPT_DEFS += -DI2C_ASYNC_ENABLE
+    QUANTUM_LIB_SRC += i2c_async.c
+endif
+
 ifeq ($(strip $(I2C_DRIVER_REQUIRED)), yes)
     OPT_DEFS += -DHAL_USE_I2C=TRUE
     QUANTUM_LIB_SRC += i2c_master.c
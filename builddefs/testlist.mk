@@ -1,6 +1,10 @@
 TEST_LIST = $(sort $(patsubst %/test.mk,%, $(shell find $(ROOT_DIR)tests -type f -name test.mk)))
 FULL_TESTS := $(notdir $(TEST_LIST))
 
+# Benchmarks are only run when asked for by name, they are not part of test:all
+BENCHMARK_LIST :=
+
+include $(QUANTUM_PATH)/color/tests/testlist.mk
 include $(QUANTUM_PATH)/debounce/tests/testlist.mk
 include $(QUANTUM_PATH)/encoder/tests/testlist.mk
 include $(QUANTUM_PATH)/os_detection/tests/testlist.mk
@@ -8,6 +12,11 @@ include $(QUANTUM_PATH)/sequencer/tests/testlist.mk
 include $(QUANTUM_PATH)/wear_leveling/tests/testlist.mk
 include $(PLATFORM_PATH)/test/testlist.mk
 
+TEST_LIST += $(BENCHMARK_LIST)
+
+# The fixture benchmarks are found along with the other fixture tests
+BENCHMARK_LIST += $(filter %/tests/benchmark %/tests/rgb_matrix_benchmark %/tests/rgb_matrix_benchmark/uniform_flags,$(TEST_LIST))
+
 define VALIDATE_TEST_LIST
     ifneq ($1,)
         ifeq ($$(findstring -,$1),-)
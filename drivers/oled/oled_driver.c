@@ -111,6 +111,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #if !defined(OLED_PRE_CHARGE_PERIOD)
 #    define OLED_PRE_CHARGE_PERIOD 0xF1
 #endif
+// Unchanged bytes between two changed ranges on a page which are sent
+// rather than starting another addressed write
+#if !defined(OLED_RENDER_MERGE_GAP)
+#    define OLED_RENDER_MERGE_GAP 8
+#endif
 
 #define OLED_ALL_BLOCKS_MASK (((((OLED_BLOCK_TYPE)1 << (OLED_BLOCK_COUNT - 1)) - 1) << 1) | 1)
 
@@ -156,6 +161,12 @@ uint8_t         oled_rotation_width = 0;
 uint8_t         oled_scroll_speed   = 0; // this holds the speed after being remapped to ssd1306 internal values
 uint8_t         oled_scroll_start   = 0;
 uint8_t         oled_scroll_end     = 7;
+#if OLED_SHADOW_BUFFER
+// What was last sent to the display, to skip bytes which did not change
+static uint8_t         oled_shadow[OLED_MATRIX_SIZE];
+static OLED_BLOCK_TYPE oled_synced = 0; // Blocks whose shadow matches the display
+#endif
+
 #if OLED_TIMEOUT > 0
 uint32_t oled_timeout;
 #endif
@@ -363,6 +374,9 @@ bool oled_init(oled_rotation_t rotation) {
 #endif
 
     oled_clear();
+#if OLED_SHADOW_BUFFER
+    oled_synced = 0;
+#endif
     oled_initialized = true;
     oled_active      = true;
     oled_scrolling   = false;
@@ -382,25 +396,6 @@ void oled_clear(void) {
     oled_dirty  = OLED_ALL_BLOCKS_MASK;
 }
 
-static void calc_bounds(uint8_t update_start, uint8_t *cmd_array) {
-    // Calculate commands to set memory addressing bounds.
-    uint8_t start_page   = OLED_BLOCK_SIZE * update_start / OLED_DISPLAY_WIDTH;
-    uint8_t start_column = OLED_BLOCK_SIZE * update_start % OLED_DISPLAY_WIDTH;
-#if !OLED_IC_HAS_HORIZONTAL_MODE
-    // Commands for Page Addressing Mode. Sets starting page and column; has no end bound.
-    // Column value must be split into high and low nybble and sent as two commands.
-    cmd_array[0] = PAM_PAGE_ADDR | start_page;
-    cmd_array[1] = PAM_SETCOLUMN_LSB | ((OLED_COLUMN_OFFSET + start_column) & 0x0f);
-    cmd_array[2] = PAM_SETCOLUMN_MSB | ((OLED_COLUMN_OFFSET + start_column) >> 4 & 0x0f);
-#else
-    // Commands for use in Horizontal Addressing mode.
-    cmd_array[1] = start_column + OLED_COLUMN_OFFSET;
-    cmd_array[4] = start_page;
-    cmd_array[2] = (OLED_BLOCK_SIZE + OLED_DISPLAY_WIDTH - 1) % OLED_DISPLAY_WIDTH + cmd_array[1];
-    cmd_array[5] = (OLED_BLOCK_SIZE + OLED_DISPLAY_WIDTH - 1) / OLED_DISPLAY_WIDTH - 1 + cmd_array[4];
-#endif
-}
-
 static void calc_bounds_90(uint8_t update_start, uint8_t *cmd_array) {
     // Block numbering starts from the bottom left corner, going up and then to
     // the right.  The controller needs the page and column numbers for the top
@@ -431,50 +426,144 @@ static void calc_bounds_90(uint8_t update_start, uint8_t *cmd_array) {
 #endif
 }
 
-uint8_t crot(uint8_t a, int8_t n) {
-    const uint8_t mask = 0x7;
-    n &= mask;
-    return a << n | a >> (-n & mask);
-}
+// Spreads the bits of a nibble into the lowest bit of four bytes, least significant byte first
+static const uint32_t PROGMEM oled_spread_lut[16] = {
+    0x00000000, 0x00000001, 0x00000100, 0x00000101, 0x00010000, 0x00010001, 0x00010100, 0x00010101,
+    0x01000000, 0x01000001, 0x01000100, 0x01000101, 0x01010000, 0x01010001, 0x01010100, 0x01010101,
+};
 
+// Rotates an 8x8 pixel tile: bit i of src[j] becomes bit 7 - j of dest[i]
 static void rotate_90(const uint8_t *src, uint8_t *dest) {
-    for (uint8_t i = 0, shift = 7; i < 8; ++i, --shift) {
-        uint8_t selector = (1 << i);
-        for (uint8_t j = 0; j < 8; ++j) {
-            dest[i] |= crot(src[j] & selector, shift - (int8_t)j);
-        }
+    uint32_t low = 0, high = 0;
+    for (uint8_t j = 0; j < 8; ++j) {
+        low |= pgm_read_dword(&oled_spread_lut[src[j] & 0x0F]) << (7 - j);
+        high |= pgm_read_dword(&oled_spread_lut[src[j] >> 4]) << (7 - j);
+    }
+    for (uint8_t i = 0; i < 4; ++i) {
+        dest[i]     = low >> (8 * i);
+        dest[i + 4] = high >> (8 * i);
     }
 }
 
-void oled_render_dirty(bool all) {
-    // Do we have work to do?
-    oled_dirty &= OLED_ALL_BLOCKS_MASK;
-    if (!oled_dirty || !oled_initialized || oled_scrolling) {
-        return;
+// Sends oled_buffer[start, end) in one addressed write, the range must be within a page
+static bool oled_send_range(uint16_t start, uint16_t end) {
+    uint8_t page   = start / OLED_DISPLAY_WIDTH;
+    uint8_t column = start % OLED_DISPLAY_WIDTH + OLED_COLUMN_OFFSET;
+#if OLED_IC_HAS_HORIZONTAL_MODE
+    uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, column, column + (end - start) - 1, PAGE_ADDR, page, page};
+#else
+    uint8_t display_start[] = {I2C_CMD, PAM_PAGE_ADDR | page, PAM_SETCOLUMN_LSB | (column & 0x0f), PAM_SETCOLUMN_MSB | (column >> 4 & 0x0f)};
+#endif
+    if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
+        print("oled_render offset command failed\n");
+        return false;
+    }
+    if (!oled_send_data(&oled_buffer[start], end - start)) {
+        print("oled_render data failed\n");
+        return false;
     }
+#if OLED_SHADOW_BUFFER
+    memcpy(&oled_shadow[start], &oled_buffer[start], end - start);
+#endif
+    return true;
+}
 
-    // Turn on display if it is off
-    oled_on();
+// Unrotated, the buffer has the layout of the display memory. Changed bytes of the
+// dirty blocks are gathered into ranges, and ranges on the same page which are
+// close enough are merged, so that each range takes a single addressed write.
+static void oled_render_dirty_0(bool all) {
+    uint16_t        range_start = 0, range_end = 0;
+    OLED_BLOCK_TYPE range_blocks  = 0;
+    uint8_t         num_processed = 0;
+
+    for (uint8_t block = 0; block < OLED_BLOCK_COUNT && oled_dirty; ++block) {
+        OLED_BLOCK_TYPE block_mask = (OLED_BLOCK_TYPE)1 << block;
+        if (!(oled_dirty & block_mask)) {
+            continue;
+        }
+        oled_dirty &= ~block_mask;
+
+        bool changed = false;
+        for (uint16_t start = OLED_BLOCK_SIZE * block, block_end = start + OLED_BLOCK_SIZE; start < block_end;) {
+            // Blocks larger than a page are split at page boundaries
+            uint16_t page_end = (start / OLED_DISPLAY_WIDTH + 1) * OLED_DISPLAY_WIDTH;
+            uint16_t end      = page_end < block_end ? page_end : block_end;
+            uint16_t next     = end;
+
+#if OLED_SHADOW_BUFFER
+            if (oled_synced & block_mask) {
+                while (start < end && oled_buffer[start] == oled_shadow[start]) {
+                    ++start;
+                }
+                while (end > start && oled_buffer[end - 1] == oled_shadow[end - 1]) {
+                    --end;
+                }
+            }
+#endif
+
+            if (start < end) {
+                changed = true;
+                if (range_end > range_start && start / OLED_DISPLAY_WIDTH == range_start / OLED_DISPLAY_WIDTH && start <= range_end + OLED_RENDER_MERGE_GAP) {
+                    range_end = end;
+                } else {
+                    if (range_end > range_start && !oled_send_range(range_start, range_end)) {
+                        oled_dirty |= range_blocks | block_mask;
+#if OLED_SHADOW_BUFFER
+                        oled_synced &= ~(range_blocks | block_mask);
+#endif
+                        return;
+                    }
+                    range_start  = start;
+                    range_end    = end;
+                    range_blocks = 0;
+                }
+                range_blocks |= block_mask;
+            }
+            start = next;
+        }
 
+#if OLED_SHADOW_BUFFER
+        oled_synced |= block_mask;
+#endif
+        // Only blocks which had to be sent count towards the limit
+        if (changed && ++num_processed >= OLED_UPDATE_PROCESS_LIMIT && !all) {
+            break;
+        }
+    }
+
+    if (range_end > range_start && !oled_send_range(range_start, range_end)) {
+        oled_dirty |= range_blocks;
+#if OLED_SHADOW_BUFFER
+        oled_synced &= ~range_blocks;
+#endif
+    }
+}
+
+static void oled_render_dirty_90(bool all) {
     uint8_t update_start  = 0;
     uint8_t num_processed = 0;
-    while (oled_dirty && (num_processed++ < OLED_UPDATE_PROCESS_LIMIT || all)) { // render all dirty blocks (up to the configured limit)
+    while (oled_dirty && (num_processed < OLED_UPDATE_PROCESS_LIMIT || all)) { // render all dirty blocks (up to the configured limit)
         // Find next dirty block
         while (!(oled_dirty & ((OLED_BLOCK_TYPE)1 << update_start))) {
             ++update_start;
         }
 
+#if OLED_SHADOW_BUFFER
+        // Rotated blocks are only sent as a whole, skip the ones that did not change
+        if ((oled_synced & ((OLED_BLOCK_TYPE)1 << update_start)) && memcmp(&oled_buffer[OLED_BLOCK_SIZE * update_start], &oled_shadow[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE) == 0) {
+            oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start);
+            continue;
+        }
+#endif
+        ++num_processed;
+
         // Set column & page position
 #if OLED_IC_HAS_HORIZONTAL_MODE
         static uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, 0, OLED_DISPLAY_WIDTH - 1, PAGE_ADDR, 0, OLED_DISPLAY_HEIGHT / 8 - 1};
 #else
         static uint8_t display_start[] = {I2C_CMD, PAM_PAGE_ADDR, PAM_SETCOLUMN_LSB, PAM_SETCOLUMN_MSB};
 #endif
-        if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
-            calc_bounds(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
-        } else {
-            calc_bounds_90(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
-        }
+        calc_bounds_90(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
 
         // Send column & page position
         if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
@@ -482,56 +571,68 @@ void oled_render_dirty(bool all) {
             return;
         }
 
-        if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
-            // Send render data chunk as is
-            if (!oled_send_data(&oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE)) {
-                print("oled_render data failed\n");
-                return;
-            }
-        } else {
-            // Rotate the render chunks
-            const static uint8_t source_map[] = OLED_SOURCE_MAP;
-            const static uint8_t target_map[] = OLED_TARGET_MAP;
-
-            static uint8_t temp_buffer[OLED_BLOCK_SIZE];
-            memset(temp_buffer, 0, sizeof(temp_buffer));
-            for (uint8_t i = 0; i < sizeof(source_map); ++i) {
-                rotate_90(&oled_buffer[OLED_BLOCK_SIZE * update_start + source_map[i]], &temp_buffer[target_map[i]]);
-            }
+        // Rotate the render chunks
+        const static uint8_t source_map[] = OLED_SOURCE_MAP;
+        const static uint8_t target_map[] = OLED_TARGET_MAP;
+
+        static uint8_t temp_buffer[OLED_BLOCK_SIZE];
+        for (uint8_t i = 0; i < sizeof(source_map); ++i) {
+            rotate_90(&oled_buffer[OLED_BLOCK_SIZE * update_start + source_map[i]], &temp_buffer[target_map[i]]);
+        }
 
 #if OLED_IC_HAS_HORIZONTAL_MODE
-            // Send render data chunk after rotating
-            if (!oled_send_data(&temp_buffer[0], OLED_BLOCK_SIZE)) {
-                print("oled_render90 data failed\n");
-                return;
-            }
+        // Send render data chunk after rotating
+        if (!oled_send_data(&temp_buffer[0], OLED_BLOCK_SIZE)) {
+            print("oled_render90 data failed\n");
+            return;
+        }
 #else
-            // For SH1106 or SH1107 the data chunk must be split into separate pieces for each page
-            const uint8_t columns_in_block = (OLED_BLOCK_SIZE + OLED_DISPLAY_HEIGHT - 1) / OLED_DISPLAY_HEIGHT * 8;
-            const uint8_t num_pages        = OLED_BLOCK_SIZE / columns_in_block;
-            for (uint8_t i = 0; i < num_pages; ++i) {
-                // Send column & page position for all pages except the first one
-                if (i > 0) {
-                    display_start[1]++;
-                    if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
-                        print("oled_render offset command failed\n");
-                        return;
-                    }
-                }
-                // Send data for the page
-                if (!oled_send_data(&temp_buffer[columns_in_block * i], columns_in_block)) {
-                    print("oled_render90 data failed\n");
+        // For SH1106 or SH1107 the data chunk must be split into separate pieces for each page
+        const uint8_t columns_in_block = (OLED_BLOCK_SIZE + OLED_DISPLAY_HEIGHT - 1) / OLED_DISPLAY_HEIGHT * 8;
+        const uint8_t num_pages        = OLED_BLOCK_SIZE / columns_in_block;
+        for (uint8_t i = 0; i < num_pages; ++i) {
+            // Send column & page position for all pages except the first one
+            if (i > 0) {
+                display_start[1]++;
+                if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
+                    print("oled_render offset command failed\n");
                     return;
                 }
             }
-#endif
+            // Send data for the page
+            if (!oled_send_data(&temp_buffer[columns_in_block * i], columns_in_block)) {
+                print("oled_render90 data failed\n");
+                return;
+            }
         }
+#endif
 
+#if OLED_SHADOW_BUFFER
+        memcpy(&oled_shadow[OLED_BLOCK_SIZE * update_start], &oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE);
+        oled_synced |= ((OLED_BLOCK_TYPE)1 << update_start);
+#endif
         // Clear dirty flag of just rendered block
         oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start);
     }
 }
 
+void oled_render_dirty(bool all) {
+    // Do we have work to do?
+    oled_dirty &= OLED_ALL_BLOCKS_MASK;
+    if (!oled_dirty || !oled_initialized || oled_scrolling) {
+        return;
+    }
+
+    // Turn on display if it is off
+    oled_on();
+
+    if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
+        oled_render_dirty_0(all);
+    } else {
+        oled_render_dirty_90(all);
+    }
+}
+
 void oled_set_cursor(uint8_t col, uint8_t line) {
     uint16_t index = line * oled_rotation_width + col * OLED_FONT_WIDTH;
 
@@ -878,6 +979,10 @@ bool oled_scroll_off(void) {
         }
         oled_scrolling = false;
         oled_dirty     = OLED_ALL_BLOCKS_MASK;
+#if OLED_SHADOW_BUFFER
+        // Scrolling moved the contents of the display memory
+        oled_synced = 0;
+#endif
     }
     return !oled_scrolling;
 }
@@ -3,9 +3,20 @@
 
 #ifdef QUANTUM_PAINTER_SPI_ENABLE
 
+#    include <string.h>
 #    include "spi_master.h"
 #    include "qp_comms_spi.h"
 
+#    if QUANTUM_PAINTER_SPI_ASYNC_TRANSFERS && !defined(PROTOCOL_CHIBIOS)
+#        error "QUANTUM_PAINTER_SPI_ASYNC_TRANSFERS needs spi_transmit_async(), which is only implemented by the ChibiOS SPI driver. Please disable it on this platform."
+#    endif
+
+#    if QUANTUM_PAINTER_SPI_ASYNC_TRANSFERS
+// Transfer buffers, one is sent by DMA while the caller prepares the data for the other
+static uint8_t qp_comms_spi_transfer_buffers[2][QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE] __attribute__((__aligned__(4)));
+static uint8_t qp_comms_spi_transfer_index = 0;
+#    endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Base SPI support
 
@@ -45,18 +56,48 @@ uint32_t qp_comms_spi_send_data(painter_device_t device, const void *data, uint3
     return byte_count - bytes_remaining;
 }
 
+#    if QUANTUM_PAINTER_SPI_ASYNC_TRANSFERS
+uint32_t qp_comms_spi_send_data_async(painter_device_t device, const void *data, uint32_t byte_count) {
+    uint32_t       bytes_remaining = byte_count;
+    const uint8_t *p               = (const uint8_t *)data;
+
+    while (bytes_remaining > 0) {
+        // The transfer started before the previous one used this buffer, and has finished by now
+        uint8_t *buffer          = qp_comms_spi_transfer_buffers[qp_comms_spi_transfer_index];
+        uint32_t bytes_this_loop = QP_MIN(bytes_remaining, sizeof(qp_comms_spi_transfer_buffers[0]));
+        qp_comms_spi_transfer_index ^= 1;
+
+        memcpy(buffer, p, bytes_this_loop);
+        spi_transmit_async(buffer, bytes_this_loop);
+        p += bytes_this_loop;
+        bytes_remaining -= bytes_this_loop;
+    }
+
+    return byte_count - bytes_remaining;
+}
+#    endif // QUANTUM_PAINTER_SPI_ASYNC_TRANSFERS
+
 void qp_comms_spi_stop(painter_device_t device) {
+#    if QUANTUM_PAINTER_SPI_ASYNC_TRANSFERS
+    // Returns straight away if a transfer is still running, the chip select is released once it completes
+    spi_stop();
+#    else
     painter_driver_t *     driver       = (painter_driver_t *)device;
     qp_comms_spi_config_t *comms_config = (qp_comms_spi_config_t *)driver->comms_config;
     spi_stop();
     gpio_write_pin_high(comms_config->chip_select_pin);
+#    endif
 }
 
 const painter_comms_vtable_t spi_comms_vtable = {
     .comms_init  = qp_comms_spi_init,
     .comms_start = qp_comms_spi_start,
-    .comms_send  = qp_comms_spi_send_data,
-    .comms_stop  = qp_comms_spi_stop,
+#    if QUANTUM_PAINTER_SPI_ASYNC_TRANSFERS
+    .comms_send = qp_comms_spi_send_data_async,
+#    else
+    .comms_send = qp_comms_spi_send_data,
+#    endif
+    .comms_stop = qp_comms_spi_stop,
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -97,9 +138,22 @@ uint32_t qp_comms_spi_dc_reset_send_data(painter_device_t device, const void *da
     return qp_comms_spi_send_data(device, data, byte_count);
 }
 
+#        if QUANTUM_PAINTER_SPI_ASYNC_TRANSFERS
+uint32_t qp_comms_spi_dc_reset_send_data_async(painter_device_t device, const void *data, uint32_t byte_count) {
+    painter_driver_t *              driver       = (painter_driver_t *)device;
+    qp_comms_spi_dc_reset_config_t *comms_config = (qp_comms_spi_dc_reset_config_t *)driver->comms_config;
+    gpio_write_pin_high(comms_config->dc_pin);
+    return qp_comms_spi_send_data_async(device, data, byte_count);
+}
+#        endif // QUANTUM_PAINTER_SPI_ASYNC_TRANSFERS
+
 void qp_comms_spi_dc_reset_send_command(painter_device_t device, uint8_t cmd) {
     painter_driver_t *              driver       = (painter_driver_t *)device;
     qp_comms_spi_dc_reset_config_t *comms_config = (qp_comms_spi_dc_reset_config_t *)driver->comms_config;
+#        if QUANTUM_PAINTER_SPI_ASYNC_TRANSFERS
+    // Pixel data may still be on the wire
+    spi_transmit_wait();
+#        endif
     gpio_write_pin_low(comms_config->dc_pin);
     spi_write(cmd);
 }
@@ -133,8 +187,12 @@ const painter_comms_with_command_vtable_t spi_comms_with_dc_vtable = {
         {
             .comms_init  = qp_comms_spi_dc_reset_init,
             .comms_start = qp_comms_spi_start,
-            .comms_send  = qp_comms_spi_dc_reset_send_data,
-            .comms_stop  = qp_comms_spi_stop,
+#        if QUANTUM_PAINTER_SPI_ASYNC_TRANSFERS
+            .comms_send = qp_comms_spi_dc_reset_send_data_async,
+#        else
+            .comms_send = qp_comms_spi_dc_reset_send_data,
+#        endif
+            .comms_stop = qp_comms_spi_stop,
         },
     .send_command          = qp_comms_spi_dc_reset_send_command,
     .bulk_command_sequence = qp_comms_spi_dc_reset_bulk_command_sequence,
@@ -28,6 +28,11 @@ void soft_serial_target_init(void);
 
 bool soft_serial_transaction(int sstd_index);
 
+#ifdef SERIAL_PIPELINE_ENABLE
+// queues the transaction without waiting for the response, failures are reported by later calls
+bool soft_serial_transaction_async(int sstd_index);
+#endif
+
 #ifdef SERIAL_DEBUG
 #    include <debug.h>
 #    include <print.h>
@@ -42,6 +42,7 @@ def compile(cli):
         cli.config.mass_compile.keymap = cli.config.compile.keymap
         cli.config.mass_compile.parallel = cli.config.compile.parallel
         cli.args.no_temp = False
+        cli.args.cache = False
         return mass_compile(cli)
 
     # If we've received `-km all`, reroute it to mass-compile.
@@ -52,6 +53,7 @@ def compile(cli):
         cli.config.mass_compile.keymap = None
         cli.config.mass_compile.parallel = cli.config.compile.parallel
         cli.args.no_temp = False
+        cli.args.cache = False
         return mass_compile(cli)
 
     # Build the environment vars
@@ -176,6 +176,20 @@ def generate_led_animations_config(feature, led_feature_json, config_h_lines, en
             config_h_lines.append(generate_define(f'{enable_prefix}{animation.upper()}'))
 
 
+def generate_led_flags_config(feature, led_feature_json, config_h_lines):
+    """Fold the LED flags into the effect runners when asked for and every LED has the same flags.
+    """
+    if not led_feature_json.get('uniform_flags', False):
+        return
+
+    flags = {led.get('flags', 0) for led in led_feature_json.get('layout', [])}
+
+    if len(flags) == 1:
+        config_h_lines.append(generate_define(f'{feature.upper()}_LED_FLAGS_UNIFORM', flags.pop()))
+    else:
+        cli.log.warning(f'{feature}.uniform_flags is set, but the LEDs of {feature}.layout have different flags. Skipping {feature.upper()}_LED_FLAGS_UNIFORM.')
+
+
 @cli.argument('filename', nargs='?', arg_only=True, type=FileType('r'), completer=FilesCompleter('.json'), help='A configurator export JSON to be compiled and flashed or a pre-compiled binary firmware file (bin/hex) to be flashed.')
 @cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
 @cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
@@ -215,9 +229,11 @@ def generate_config_h(cli):
 
     if 'led_matrix' in kb_info_json:
         generate_led_animations_config('led_matrix', kb_info_json['led_matrix'], config_h_lines, 'ENABLE_LED_MATRIX_', 'LED_MATRIX_')
+        generate_led_flags_config('led_matrix', kb_info_json['led_matrix'], config_h_lines)
 
     if 'rgb_matrix' in kb_info_json:
         generate_led_animations_config('rgb_matrix', kb_info_json['rgb_matrix'], config_h_lines, 'ENABLE_RGB_MATRIX_', 'RGB_MATRIX_')
+        generate_led_flags_config('rgb_matrix', kb_info_json['rgb_matrix'], config_h_lines)
 
     if 'rgblight' in kb_info_json:
         generate_led_animations_config('rgblight', kb_info_json['rgblight'], config_h_lines, 'RGBLIGHT_EFFECT_', 'RGBLIGHT_MODE_')
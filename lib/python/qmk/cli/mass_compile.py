@@ -3,7 +3,10 @@
 This will compile everything in parallel, for testing purposes.
 """
 import os
-from typing import List
+import sys
+import json
+import shlex
+from typing import Dict, List
 from pathlib import Path
 from subprocess import DEVNULL
 from milc import cli
@@ -14,13 +17,76 @@ from qmk.search import search_keymap_targets, search_make_targets
 from qmk.build_targets import BuildTarget, JsonKeymapBuildTarget
 
 
-def mass_compile_targets(targets: List[BuildTarget], clean: bool, dry_run: bool, no_temp: bool, parallel: int, **env):
+def _load_build_durations(durations_file: Path) -> Dict[str, float]:
+    """Returns the build durations recorded by previous runs, keyed by `keyboard:keymap`.
+    """
+    try:
+        return json.loads(durations_file.read_text(encoding='utf-8'))
+    except (OSError, ValueError):
+        return {}
+
+
+def _record_build_durations(durations_file: Path, builddir: Path):
+    """Collects the timing logs written by the builds of this run into `durations_file`.
+    """
+    durations = _load_build_durations(durations_file)
+
+    for timing_log in builddir.glob(f'timing.log.{os.getpid()}.*'):
+        try:
+            lines = timing_log.read_text(encoding='utf-8').split()
+            target = lines[0]
+            durations[target] = int(lines[2]) - int(lines[1])
+        except (OSError, IndexError, ValueError):
+            pass
+        timing_log.unlink()
+
+    durations_file.write_text(json.dumps(durations, sort_keys=True), encoding='utf-8')
+
+
+def _schedule_targets(targets: List[BuildTarget], durations: Dict[str, float]) -> List[BuildTarget]:
+    """Orders targets so that the most expensive builds start first.
+
+    make hands out jobs in prerequisite order, so starting the longest builds first keeps a slow
+    target from being picked up last and leaving the remaining cores idle at the end of the run.
+    Targets without a recorded duration are estimated using the median of the known ones.
+    """
+    targets = sorted(targets, key=lambda t: (t.keyboard, t.keymap))
+    if not durations:
+        return targets
+
+    known = sorted(durations.values())
+    estimate = known[len(known) // 2]
+    return sorted(targets, key=lambda t: durations.get(str(t), estimate), reverse=True)
+
+
+def _object_cache_environment(builddir: Path) -> Dict[str, str]:
+    """Make variables that route every compile through `qmk.object_cache`, with a cache shared by all targets.
+
+    Every target includes its generated headers from its own obj_<keyboard>_<keymap> directory, which ends up
+    in the line markers of the preprocessed source. ccache hashes those paths, so it never hits across targets.
+    The object cache leaves line markers out of the key and normalizes the target directory, so common
+    quantum/, tmk_core/ and platforms/ objects are only compiled once per MCU and config signature.
+
+    Debug info records those paths too, so it is turned off unless asked for with `-e SKIP_DEBUG_INFO=no`.
+    """
+    lib_python = (Path(QMK_FIRMWARE) / 'lib' / 'python').resolve().as_posix()
+    prefix = f'env PYTHONPATH={shlex.quote(lib_python)} {shlex.quote(sys.executable)} -m qmk.object_cache'
+
+    return {
+        'CC_PREFIX': shlex.quote(prefix),
+        'QMK_OBJECT_CACHE_DIR': (builddir / 'object_cache').resolve().as_posix(),
+        'SKIP_DEBUG_INFO': 'yes',
+    }
+
+
+def mass_compile_targets(targets: List[BuildTarget], clean: bool, dry_run: bool, no_temp: bool, parallel: int, cache: bool = False, **env):
     if len(targets) == 0:
         return
 
     make_cmd = find_make()
     builddir = Path(QMK_FIRMWARE) / '.build'
     makefile = builddir / 'parallel_kb_builds.mk'
+    durations_file = builddir / 'mass_compile_durations.json'
 
     if dry_run:
         cli.log.info('Compilation targets:')
@@ -30,9 +96,12 @@ def mass_compile_targets(targets: List[BuildTarget], clean: bool, dry_run: bool,
         if clean:
             cli.run([make_cmd, 'clean'], capture_output=False, stdin=DEVNULL)
 
+        if cache:
+            env = {**_object_cache_environment(builddir), **env}
+
         builddir.mkdir(parents=True, exist_ok=True)
         with open(makefile, "w") as f:
-            for target in sorted(targets, key=lambda t: (t.keyboard, t.keymap)):
+            for target in _schedule_targets(targets, _load_build_durations(durations_file)):
                 keyboard_name = target.keyboard
                 keymap_name = target.keymap
                 target.configure(parallel=1)  # We ignore parallelism on a per-build basis as we defer to the parent make invocation
@@ -42,12 +111,14 @@ def mass_compile_targets(targets: List[BuildTarget], clean: bool, dry_run: bool,
                 keyboard_safe = keyboard_name.replace('/', '_')
                 build_log = f"{QMK_FIRMWARE}/.build/build.log.{os.getpid()}.{keyboard_safe}.{keymap_name}"
                 failed_log = f"{QMK_FIRMWARE}/.build/failed.log.{os.getpid()}.{keyboard_safe}.{keymap_name}"
+                timing_log = f"{QMK_FIRMWARE}/.build/timing.log.{os.getpid()}.{keyboard_safe}.{keymap_name}"
                 # yapf: disable
                 f.write(
                     f"""\
 all: {keyboard_safe}_{keymap_name}_binary
 {keyboard_safe}_{keymap_name}_binary:
 	@rm -f "{build_log}" || true
+	@echo "{keyboard_name}:{keymap_name} $$(date +%s)" >"{timing_log}"
 	@echo "Compiling QMK Firmware for target: '{keyboard_name}:{keymap_name}'..." >>"{build_log}"
 	{' '.join(command)} \\
 		>>"{build_log}" 2>&1 \\
@@ -55,6 +126,7 @@ all: {keyboard_safe}_{keymap_name}_binary
 	@{{ grep '\\[ERRORS\\]' "{build_log}" >/dev/null 2>&1 && printf "Build %-64s \\e[1;31m[ERRORS]\\e[0m\\n" "{keyboard_name}:{keymap_name}" ; }} \\
 		|| {{ grep '\\[WARNINGS\\]' "{build_log}" >/dev/null 2>&1 && printf "Build %-64s \\e[1;33m[WARNINGS]\\e[0m\\n" "{keyboard_name}:{keymap_name}" ; }} \\
 		|| printf "Build %-64s \\e[1;32m[OK]\\e[0m\\n" "{keyboard_name}:{keymap_name}"
+	@echo "$$(date +%s)" >>"{timing_log}"
 	@rm -f "{build_log}" || true
 """# noqa
                 )
@@ -74,6 +146,8 @@ all: {keyboard_safe}_{keymap_name}_binary
 
         cli.run([find_make(), *get_make_parallel_args(parallel), '-f', makefile.as_posix(), 'all'], capture_output=False, stdin=DEVNULL)
 
+        _record_build_durations(durations_file, builddir)
+
         # Check for failures
         failures = [f for f in builddir.glob(f'failed.log.{os.getpid()}.*')]
         if len(failures) > 0:
@@ -82,6 +156,7 @@ all: {keyboard_safe}_{keymap_name}_binary
 
 @cli.argument('builds', nargs='*', arg_only=True, help="List of builds in form <keyboard>:<keymap> to compile in parallel. Specifying this overrides all other target search options.")
 @cli.argument('-t', '--no-temp', arg_only=True, action='store_true', help="Remove temporary files during build.")
+@cli.argument('-C', '--cache', arg_only=True, action='store_true', help="Share compiled objects between targets through a cache keyed on the preprocessed source.")
 @cli.argument('-j', '--parallel', type=int, default=1, help="Set the number of parallel make jobs; 0 means unlimited.")
 @cli.argument('-c', '--clean', arg_only=True, action='store_true', help="Remove object files before compiling.")
 @cli.argument('-n', '--dry-run', arg_only=True, action='store_true', help="Don't actually build, just show the commands to be run.")
@@ -108,4 +183,4 @@ def mass_compile(cli):
     else:
         targets = search_keymap_targets([('all', cli.config.mass_compile.keymap)], cli.args.filter)
 
-    return mass_compile_targets(targets, cli.args.clean, cli.args.dry_run, cli.args.no_temp, cli.config.mass_compile.parallel, **build_environment(cli.args.env))
+    return mass_compile_targets(targets, cli.args.clean, cli.args.dry_run, cli.args.no_temp, cli.config.mass_compile.parallel, cli.args.cache, **build_environment(cli.args.env))
@@ -0,0 +1,140 @@
+"""Content addressed object cache shared between build targets.
+
+Used as the compiler prefix by `qmk mass-compile --cache`:
+
+    PYTHONPATH=lib/python python3 -m qmk.object_cache arm-none-eabi-gcc -c ... -o foo.o
+
+Objects are keyed on the preprocessed source and the options that don't affect preprocessing. Line
+markers are left out of the key and the per-target build directory is normalized, so a common
+quantum/, tmk_core/ or platforms/ object is only compiled once for all targets that preprocess it
+the same way. The object is always compiled from the original source, the key only decides whether
+it has to be.
+
+With debug info enabled the object records the file names and line numbers from the line markers,
+so the key is taken from the unmodified options and preprocessed source instead, and objects are
+only shared between targets that would produce identical debug info.
+
+This runs once per compile, so it only imports the standard library.
+"""
+import hashlib
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+from pathlib import Path
+
+# Options whose effect is in the preprocessed output
+PREPROCESSOR_OPTIONS = ('-D', '-U', '-I', '-include', '-imacros', '-iquote', '-isystem', '-idirafter')
+DEPENDENCY_OPTIONS = ('-MF', '-MT', '-MQ')
+DEPENDENCY_FLAGS = ('-M', '-MM', '-MD', '-MMD', '-MP', '-MG')
+
+# obj_<keyboard>_<keymap> build directories, see INTERMEDIATE_OUTPUT
+TARGET_DIR = re.compile(r'\bobj_[^/\s"]+/')
+LINE_MARKER = re.compile(rb'^# \d+ ".*"[ \d]*$', re.MULTILINE)
+
+
+def _option(args, index):
+    """Returns the preprocessor, dependency or output option at args[index], if any, and how many arguments it takes up.
+    """
+    arg = args[index]
+    for option in PREPROCESSOR_OPTIONS + DEPENDENCY_OPTIONS + ('-o', ):
+        if arg == option:
+            return option, 2
+        if arg.startswith(option) and option not in ('-include', '-imacros'):
+            return option, 1
+    if arg in DEPENDENCY_FLAGS:
+        return arg, 1
+    return None, 1
+
+
+def debug_info(args):
+    """Whether the object gets debug info, the last -g option wins.
+    """
+    enabled = False
+    for arg in args:
+        if arg.startswith('-g'):
+            enabled = arg != '-g0'
+    return enabled
+
+
+def cache_key(compiler, args, preprocessed):
+    """Hashes the compiler, the options that affect code generation and the preprocessed source.
+    """
+    debug = debug_info(args)
+    key = hashlib.sha256()
+
+    stat = os.stat(compiler)
+    key.update(f'{compiler}\0{stat.st_size}\0{stat.st_mtime_ns}\0'.encode())
+
+    index = 0
+    while index < len(args):
+        option, count = _option(args, index)
+        if option is None:
+            key.update((args[index] if debug else TARGET_DIR.sub('obj_/', args[index])).encode() + b'\0')
+        index += count
+
+    key.update(preprocessed if debug else LINE_MARKER.sub(b'', preprocessed))
+    return key.hexdigest()
+
+
+def preprocess_args(args, output):
+    """The arguments to preprocess the source the same way, writing the dependency file if requested.
+    """
+    cpp_args = []
+    has_target = False
+    index = 0
+    while index < len(args):
+        option, count = _option(args, index)
+        if option in ('-MT', '-MQ'):
+            has_target = True
+        if option != '-o' and args[index] != '-c':
+            cpp_args.extend(args[index:index + count])
+        index += count
+
+    # With -E, the dependency target is no longer taken from -o
+    if not has_target and any(arg in ('-MD', '-MMD') for arg in args):
+        cpp_args.extend(['-MQ', output])
+
+    return cpp_args + ['-E']
+
+
+def _store(cache_file, output):
+    """Adds the object to the cache, other compiles may be reading it at the same time.
+    """
+    cache_file.parent.mkdir(parents=True, exist_ok=True)
+    fd, temp = tempfile.mkstemp(dir=cache_file.parent)
+    with os.fdopen(fd, 'wb') as f:
+        f.write(Path(output).read_bytes())
+    os.replace(temp, cache_file)
+
+
+def main(argv):
+    compiler, args = argv[0], argv[1:]
+    cache_dir = Path(os.environ.get('QMK_OBJECT_CACHE_DIR', '.build/object_cache'))
+
+    # Linking, or preprocessing only
+    if '-c' not in args or '-o' not in args:
+        return subprocess.call(argv)
+
+    output = args[args.index('-o') + 1]
+    cpp = subprocess.run([compiler, *preprocess_args(args, output)], stdout=subprocess.PIPE)
+    if cpp.returncode != 0:
+        return subprocess.call(argv)
+
+    key = cache_key(shutil.which(compiler) or compiler, args, cpp.stdout)
+    cache_file = cache_dir / key[:2] / f'{key}.o'
+
+    if cache_file.exists():
+        Path(output).write_bytes(cache_file.read_bytes())
+        return 0
+
+    returncode = subprocess.call(argv)
+    if returncode == 0:
+        _store(cache_file, output)
+    return returncode
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,40 @@
+from qmk.build_targets import KeyboardKeymapBuildTarget
+from qmk.cli.mass_compile import _schedule_targets
+
+
+def _targets(*names):
+    return [KeyboardKeymapBuildTarget(*name.split(':')) for name in names]
+
+
+def test_schedule_targets_without_durations():
+    targets = _targets('handwired/pytest/macro:default', 'handwired/pytest/basic:default_json', 'handwired/pytest/basic:default')
+    scheduled = _schedule_targets(targets, {})
+    assert [str(t) for t in scheduled] == ['handwired/pytest/basic:default', 'handwired/pytest/basic:default_json', 'handwired/pytest/macro:default']
+
+
+def test_schedule_targets_longest_first():
+    targets = _targets('handwired/pytest/basic:default', 'handwired/pytest/macro:default', 'handwired/pytest/has_template:default')
+    durations = {
+        'handwired/pytest/basic:default': 10,
+        'handwired/pytest/macro:default': 30,
+        'handwired/pytest/has_template:default': 20,
+    }
+    scheduled = _schedule_targets(targets, durations)
+    assert [str(t) for t in scheduled] == ['handwired/pytest/macro:default', 'handwired/pytest/has_template:default', 'handwired/pytest/basic:default']
+
+
+def test_schedule_targets_estimates_unknown_with_median():
+    targets = _targets('handwired/pytest/basic:default', 'handwired/pytest/macro:default', 'handwired/pytest/has_template:default')
+    durations = {
+        'handwired/pytest/basic:default': 10,
+        'handwired/pytest/macro:default': 30,
+        'handwired/pytest/other:default': 20,
+    }
+    scheduled = _schedule_targets(targets, durations)
+    assert [str(t) for t in scheduled] == ['handwired/pytest/macro:default', 'handwired/pytest/has_template:default', 'handwired/pytest/basic:default']
+
+
+def test_schedule_targets_keeps_all_targets():
+    targets = _targets('handwired/pytest/basic:default', 'handwired/pytest/macro:default')
+    scheduled = _schedule_targets(targets, {'handwired/pytest/macro:default': 5})
+    assert sorted(str(t) for t in scheduled) == sorted(str(t) for t in targets)
@@ -0,0 +1,95 @@
+import os
+import shutil
+import subprocess
+import sys
+from pathlib import Path
+
+import pytest
+
+import qmk.object_cache
+
+requires_gcc = pytest.mark.skipif(shutil.which('gcc') is None, reason='gcc not found')
+
+
+def _build(tmp_path, target, config, flags=()):
+    """Compiles quantum/crc.c the way a target would, through the object cache.
+    """
+    src = tmp_path / f'.build/obj_{target}/src'
+    src.mkdir(parents=True, exist_ok=True)
+    (src / 'info_config.h').write_text(config)
+    (tmp_path / f'.build/obj_{target}/quantum').mkdir(parents=True, exist_ok=True)
+
+    obj = f'.build/obj_{target}/quantum/crc.o'
+    command = [
+        sys.executable, '-m', 'qmk.object_cache', 'gcc', '-c', '-Os', *flags, f'-DQMK_KEYMAP="{target}"', '-include', f'.build/obj_{target}/src/info_config.h', f'-I.build/obj_{target}/src', '-MMD', '-MP', '-MF', f'.build/obj_{target}/quantum/crc.td', 'quantum/crc.c', '-o', obj
+    ]
+    env = {**os.environ, 'QMK_OBJECT_CACHE_DIR': str(tmp_path / 'cache'), 'PYTHONPATH': str(Path(qmk.object_cache.__file__).parent.parent)}
+    subprocess.run(command, cwd=tmp_path, env=env, check=True)
+    return tmp_path / obj
+
+
+def _cached_objects(tmp_path):
+    return sorted((tmp_path / 'cache').glob('*/*.o'))
+
+
+@pytest.fixture
+def source(tmp_path):
+    (tmp_path / 'quantum').mkdir()
+    (tmp_path / 'quantum/crc.c').write_text('int table[TABLE_SIZE];\nint get(int i) { return table[i]; }\n')
+    return tmp_path
+
+
+@requires_gcc
+def test_object_cache_hits_across_targets(source):
+    # Same config, but at another path and on other lines
+    first = _build(source, 'kb_a_default', '#define TABLE_SIZE 4\n')
+    second = _build(source, 'kb_b_via', '\n\n#define TABLE_SIZE 4\n')
+
+    assert len(_cached_objects(source)) == 1
+    assert first.read_bytes() == second.read_bytes()
+    # The dependency file is still written on a hit
+    assert 'obj_kb_b_via/src/info_config.h' in (source / '.build/obj_kb_b_via/quantum/crc.td').read_text()
+
+
+@requires_gcc
+def test_object_cache_misses_on_other_config(source):
+    _build(source, 'kb_a_default', '#define TABLE_SIZE 4\n')
+    _build(source, 'kb_b_default', '#define TABLE_SIZE 8\n')
+
+    assert len(_cached_objects(source)) == 2
+
+
+@requires_gcc
+def test_object_cache_misses_on_other_lines_with_debug_info(source):
+    # The debug info of the second object points at other lines of another info_config.h
+    _build(source, 'kb_a_default', '#define TABLE_SIZE 4\n', ['-g'])
+    _build(source, 'kb_b_via', '\n\n#define TABLE_SIZE 4\n', ['-g'])
+
+    assert len(_cached_objects(source)) == 2
+
+
+def test_cache_key_ignores_preprocessor_and_output_options():
+    compiler = sys.executable
+    preprocessed = b'int x;\n'
+    first = qmk.object_cache.cache_key(compiler, ['-c', '-Os', '-DA=1', '-I.build/obj_a/src', '-include', '.build/obj_a/src/info_config.h', 'x.c', '-o', '.build/obj_a/x.o'], b'# 1 ".build/obj_a/src/info_config.h" 1\n' + preprocessed)
+    second = qmk.object_cache.cache_key(compiler, ['-c', '-Os', '-DA=2', '-I.build/obj_b/src', '-include', '.build/obj_b/src/info_config.h', 'x.c', '-o', '.build/obj_b/x.o'], b'# 1 ".build/obj_b/src/info_config.h" 1\n' + preprocessed)
+    assert first == second
+
+    optimized = qmk.object_cache.cache_key(compiler, ['-c', '-O2', 'x.c', '-o', 'x.o'], preprocessed)
+    assert optimized != qmk.object_cache.cache_key(compiler, ['-c', '-Os', 'x.c', '-o', 'x.o'], preprocessed)
+
+
+def test_cache_key_keeps_line_markers_with_debug_info():
+    compiler = sys.executable
+    first = qmk.object_cache.cache_key(compiler, ['-c', '-g', 'x.c', '-o', 'x.o'], b'# 1 "a.h"\nint x;\n')
+    second = qmk.object_cache.cache_key(compiler, ['-c', '-g', 'x.c', '-o', 'x.o'], b'# 2 "a.h"\nint x;\n')
+    assert first != second
+
+    first = qmk.object_cache.cache_key(compiler, ['-c', '-g', '-g0', 'x.c', '-o', 'x.o'], b'# 1 "a.h"\nint x;\n')
+    second = qmk.object_cache.cache_key(compiler, ['-c', '-g', '-g0', 'x.c', '-o', 'x.o'], b'# 2 "a.h"\nint x;\n')
+    assert first == second
+
+
+def test_preprocess_args_keep_dependency_target():
+    args = qmk.object_cache.preprocess_args(['-c', '-MMD', '-MF', 'x.td', 'x.c', '-o', 'obj/x.o'], 'obj/x.o')
+    assert args == ['-MMD', '-MF', 'x.td', 'x.c', '-MQ', 'obj/x.o', '-E']
@@ -33,6 +33,19 @@
 #include <ch.h>
 #include <hal.h>
 
+#ifdef I2C_ASYNC_ENABLE
+#    include "i2c_async.h"
+#    if !I2C_USE_MUTUAL_EXCLUSION
+#        error "I2C_ASYNC_ENABLE requires I2C_USE_MUTUAL_EXCLUSION to be TRUE in halconf.h"
+#    endif
+// The asynchronous worker and blocking callers share the bus
+#    define i2c_lock() i2cAcquireBus(&I2C_DRIVER)
+#    define i2c_unlock() i2cReleaseBus(&I2C_DRIVER)
+#else
+#    define i2c_lock()
+#    define i2c_unlock()
+#endif
+
 #ifndef I2C1_SCL_PIN
 #    define I2C1_SCL_PIN B6
 #endif
@@ -113,11 +126,14 @@ static const I2CConfig i2cconfig = {
  * aborting any ongoing transactions. Furthermore ChibiOS status codes are
  * converted into QMK codes.
  *
+ * Releases the bus taken at the start of the transaction.
+ *
  * @param status ChibiOS specific I2C status code
  * @return i2c_status_t QMK specific I2C status code
  */
 static i2c_status_t i2c_epilogue(const msg_t status) {
     if (status == MSG_OK) {
+        i2c_unlock();
         return I2C_STATUS_SUCCESS;
     }
 
@@ -125,6 +141,7 @@ static i2c_status_t i2c_epilogue(const msg_t status) {
     // restarted because the bus is in an uncertain state." We also issue that
     // hard stop in case of any error.
     i2cStop(&I2C_DRIVER);
+    i2c_unlock();
 
     return status == MSG_TIMEOUT ? I2C_STATUS_TIMEOUT : I2C_STATUS_ERROR;
 }
@@ -150,18 +167,21 @@ __attribute__((weak)) void i2c_init(void) {
 }
 
 i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_lock();
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (address >> 1), data, length, 0, 0, TIME_MS2I(timeout));
     return i2c_epilogue(status);
 }
 
 i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_lock();
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterReceiveTimeout(&I2C_DRIVER, (address >> 1), data, length, TIME_MS2I(timeout));
     return i2c_epilogue(status);
 }
 
 i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_lock();
     i2cStart(&I2C_DRIVER, &i2cconfig);
 
     uint8_t complete_packet[length + 1];
@@ -175,6 +195,7 @@ i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t*
 }
 
 i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_lock();
     i2cStart(&I2C_DRIVER, &i2cconfig);
 
     uint8_t complete_packet[length + 2];
@@ -189,12 +210,14 @@ i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8
 }
 
 i2c_status_t i2c_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_lock();
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (devaddr >> 1), &regaddr, 1, data, length, TIME_MS2I(timeout));
     return i2c_epilogue(status);
 }
 
 i2c_status_t i2c_read_register16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_lock();
     i2cStart(&I2C_DRIVER, &i2cconfig);
     uint8_t register_packet[2] = {regaddr >> 8, regaddr & 0xFF};
     msg_t   status             = i2cMasterTransmitTimeout(&I2C_DRIVER, (devaddr >> 1), register_packet, 2, data, length, TIME_MS2I(timeout));
@@ -207,4 +230,50 @@ __attribute__((weak)) i2c_status_t i2c_ping_address(uint8_t address, uint16_t ti
     // This approach may produce false negative results for I2C devices that do not respond to a register 0 read request.
     uint8_t data = 0;
     return i2c_readReg(address, 0, &data, sizeof(data), timeout);
-}
\ No newline at end of file
+}
+
+#ifdef I2C_ASYNC_ENABLE
+/* i2c_write_register16() copies the register address and data to the stack */
+#    define I2C_ASYNC_THREAD_MIN_STACK_SIZE (256 + 2 + I2C_ASYNC_MAX_WRITE_REGISTER_LENGTH)
+#    ifndef I2C_ASYNC_THREAD_STACK_SIZE
+#        define I2C_ASYNC_THREAD_STACK_SIZE I2C_ASYNC_THREAD_MIN_STACK_SIZE
+#    endif
+_Static_assert(I2C_ASYNC_THREAD_STACK_SIZE >= I2C_ASYNC_THREAD_MIN_STACK_SIZE, "I2C_ASYNC_THREAD_STACK_SIZE is too small for I2C_ASYNC_MAX_WRITE_REGISTER_LENGTH");
+
+static THD_WORKING_AREA(i2c_async_thread_wa, I2C_ASYNC_THREAD_STACK_SIZE);
+static thread_t *i2c_async_thread = NULL;
+static BSEMAPHORE_DECL(i2c_async_work, true);
+static BSEMAPHORE_DECL(i2c_async_done, true);
+
+/**
+ * @brief Runs queued transactions with the blocking API, so the main loop
+ * keeps scanning while the calling thread sleeps on the I2C interrupts.
+ */
+static THD_FUNCTION(i2c_async_worker, arg) {
+    (void)arg;
+    chRegSetThreadName("i2c_async");
+
+    while (true) {
+        chBSemWait(&i2c_async_work);
+
+        i2c_async_transaction_t *transaction;
+        while ((transaction = i2c_async_backend_next()) != NULL) {
+            i2c_async_backend_done(i2c_async_execute(transaction));
+            chBSemSignal(&i2c_async_done);
+        }
+    }
+}
+
+void i2c_async_backend_notify(void) {
+    if (!i2c_async_thread) {
+        i2c_async_thread = chThdCreateStatic(i2c_async_thread_wa, sizeof(i2c_async_thread_wa), HIGHPRIO, i2c_async_worker, NULL);
+    }
+    chBSemSignal(&i2c_async_work);
+}
+
+void i2c_async_backend_task(void) {}
+
+void i2c_async_backend_wait(void) {
+    chBSemWaitTimeout(&i2c_async_done, TIME_MS2I(1));
+}
+#endif
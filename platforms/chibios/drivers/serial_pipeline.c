@@ -0,0 +1,208 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "serial.h"
+#include "serial_pipeline.h"
+#include "serial_protocol.h"
+#include "synchronization_util.h"
+#include "crc.h"
+
+_Static_assert(SERIAL_PIPELINE_DEPTH >= 1 && SERIAL_PIPELINE_DEPTH <= 7, "SERIAL_PIPELINE_DEPTH must be between 1 and 7");
+_Static_assert(NUM_TOTAL_TRANSACTIONS <= 32, "Serial pipeline headers only have room for 32 transaction ids");
+
+#define HEADER_ID_MASK 0x1F
+#define HEADER_SEQ_SHIFT 5
+#define HEADER_SEQ_MASK 0x07
+
+/* A whole frame is assembled here, so the CRC covers the header and the
+ * buffer in one pass and a corrupted frame never reaches the shared memory. */
+static uint8_t frame[1 + UINT8_MAX + 1];
+
+static serial_pipeline_callback_t callbacks[NUM_TOTAL_TRANSACTIONS];
+
+/* Headers of the requests awaiting their response, oldest first. */
+static uint8_t in_flight[SERIAL_PIPELINE_DEPTH];
+static uint8_t in_flight_head;
+static uint8_t in_flight_count;
+static uint8_t next_seq;
+
+void serial_pipeline_register_callback(uint8_t transaction_id, serial_pipeline_callback_t callback) {
+    if (transaction_id < NUM_TOTAL_TRANSACTIONS) {
+        callbacks[transaction_id] = callback;
+    }
+}
+
+uint8_t serial_pipeline_in_flight(void) {
+    return in_flight_count;
+}
+
+static inline void notify(uint8_t transaction_id, bool success) {
+    if (callbacks[transaction_id]) {
+        callbacks[transaction_id](transaction_id, success);
+    }
+}
+
+static uint8_t pop_in_flight(void) {
+    uint8_t header = in_flight[in_flight_head];
+    in_flight_head = (in_flight_head + 1) % SERIAL_PIPELINE_DEPTH;
+    in_flight_count--;
+    return header;
+}
+
+/**
+ * @brief Fails every transaction in flight, as their responses can't be told
+ * apart anymore, and clears the receive queue.
+ */
+static void fail_in_flight(void) {
+    while (in_flight_count) {
+        notify(pop_in_flight() & HEADER_ID_MASK, false);
+    }
+    serial_transport_driver_clear();
+}
+
+static bool receive_response(uint8_t header) {
+    split_transaction_desc_t *transaction = &split_transaction_table[header & HEADER_ID_MASK];
+    uint8_t                   size        = transaction->target2initiator_buffer_size;
+
+    if (!serial_transport_receive(frame, 1 + size + 1)) {
+        serial_dprintf("SPLIT: receiving response failed\n");
+        return false;
+    }
+
+    if (frame[0] != header) {
+        serial_dprintf("SPLIT: response out of sequence\n");
+        return false;
+    }
+
+    if (frame[1 + size] != crc8(frame, 1 + size)) {
+        serial_dprintf("SPLIT: response checksum mismatch\n");
+        return false;
+    }
+
+    if (size) {
+        split_shared_memory_lock_autounlock();
+        memcpy(split_trans_target2initiator_buffer(transaction), &frame[1], size);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Waits for the response of the oldest transaction in flight.
+ */
+static bool complete_oldest(void) {
+    uint8_t header  = pop_in_flight();
+    bool    success = receive_response(header);
+
+    notify(header & HEADER_ID_MASK, success);
+    if (!success) {
+        fail_in_flight();
+    }
+    return success;
+}
+
+bool serial_pipeline_submit(uint8_t transaction_id) {
+    /* Sanity check that we are actually starting a valid transaction. */
+    if (transaction_id >= NUM_TOTAL_TRANSACTIONS) {
+        serial_dprintf("SPLIT: illegal transaction id\n");
+        return false;
+    }
+
+    if (in_flight_count == SERIAL_PIPELINE_DEPTH) {
+        complete_oldest();
+    }
+
+    if (!in_flight_count) {
+        /* Clear the receive queue, to start with a clean slate.
+         * Parts of failed transactions or spurious bytes could still be in it. */
+        serial_transport_driver_clear();
+    }
+
+    split_transaction_desc_t *transaction = &split_transaction_table[transaction_id];
+    uint8_t                   size        = transaction->initiator2target_buffer_size;
+    uint8_t                   header      = (next_seq << HEADER_SEQ_SHIFT) | transaction_id;
+
+    frame[0] = header;
+    if (size) {
+        split_shared_memory_lock_autounlock();
+        memcpy(&frame[1], split_trans_initiator2target_buffer(transaction), size);
+    }
+    frame[1 + size] = crc8(frame, 1 + size);
+
+    if (!serial_transport_send(frame, 1 + size + 1)) {
+        serial_dprintf("SPLIT: sending request failed\n");
+        notify(transaction_id, false);
+        fail_in_flight();
+        return false;
+    }
+
+    next_seq = (next_seq + 1) & HEADER_SEQ_MASK;
+    in_flight[(in_flight_head + in_flight_count) % SERIAL_PIPELINE_DEPTH] = header;
+    in_flight_count++;
+    return true;
+}
+
+bool serial_pipeline_flush(void) {
+    bool success = true;
+    while (in_flight_count) {
+        success &= complete_oldest();
+    }
+    return success;
+}
+
+bool serial_pipeline_transaction(uint8_t transaction_id) {
+    if (!serial_pipeline_submit(transaction_id)) {
+        return false;
+    }
+
+    /* Everything queued before has to be answered first, only the outcome of
+     * the last transaction matters here. Earlier ones report to their callbacks. */
+    bool success = true;
+    while (in_flight_count) {
+        success = complete_oldest();
+    }
+    return success;
+}
+
+bool serial_pipeline_react(void) {
+    /* Wait until there is a request for us. */
+    if (!serial_transport_receive_blocking(frame, 1)) {
+        return false;
+    }
+
+    uint8_t transaction_id = frame[0] & HEADER_ID_MASK;
+
+    /* Sanity check that we are actually responding to a valid transaction. */
+    if (transaction_id >= NUM_TOTAL_TRANSACTIONS) {
+        return false;
+    }
+
+    split_transaction_desc_t *transaction = &split_transaction_table[transaction_id];
+    uint8_t                   size        = transaction->initiator2target_buffer_size;
+
+    if (!serial_transport_receive(&frame[1], size + 1) || frame[1 + size] != crc8(frame, 1 + size)) {
+        return false;
+    }
+
+    split_shared_memory_lock_autounlock();
+
+    if (size) {
+        memcpy(split_trans_initiator2target_buffer(transaction), &frame[1], size);
+    }
+
+    /* Allow any slave processing to occur. */
+    if (transaction->slave_callback) {
+        transaction->slave_callback(transaction->initiator2target_buffer_size, split_trans_initiator2target_buffer(transaction), transaction->target2initiator_buffer_size, split_trans_target2initiator_buffer(transaction));
+    }
+
+    /* Answer with the same header, so the master can match the response. */
+    size = transaction->target2initiator_buffer_size;
+    if (size) {
+        memcpy(&frame[1], split_trans_target2initiator_buffer(transaction), size);
+    }
+    frame[1 + size] = crc8(frame, 1 + size);
+
+    return serial_transport_send(frame, 1 + size + 1);
+}
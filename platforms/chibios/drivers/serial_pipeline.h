@@ -0,0 +1,77 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/* Pipelined split transactions on top of the serial_protocol.h transport.
+ *
+ * Instead of the handshake per transaction, the master sends self describing
+ * frames and keeps up to SERIAL_PIPELINE_DEPTH of them in flight:
+ *
+ *   request:  [header][initiator2target buffer][crc8]
+ *   response: [header][target2initiator buffer][crc8]
+ *
+ * The header carries the transaction id in the low 5 bits and a 3 bit sequence
+ * number in the upper bits, which the slave echoes back. Responses arrive in
+ * request order, so any mismatch, CRC error or timeout fails every transaction
+ * in flight and the link starts over with a clean slate.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @def SERIAL_PIPELINE_DEPTH
+ * @brief Number of transactions that may be awaiting their response, between 1 and 7.
+ *
+ * Half duplex links share one wire for both directions, so the master must not
+ * send while the slave may be answering.
+ */
+#ifndef SERIAL_PIPELINE_DEPTH
+#    ifdef SERIAL_USART_FULL_DUPLEX
+#        define SERIAL_PIPELINE_DEPTH 4
+#    else
+#        define SERIAL_PIPELINE_DEPTH 1
+#    endif
+#endif
+
+typedef void (*serial_pipeline_callback_t)(uint8_t transaction_id, bool success);
+
+/**
+ * @brief Registers the function that is called on the master once a response
+ * for the given transaction id has been received, or the transaction failed.
+ */
+void serial_pipeline_register_callback(uint8_t transaction_id, serial_pipeline_callback_t callback);
+
+/**
+ * @brief Sends a transaction to the slave without waiting for its response.
+ * If the pipeline is full, the oldest transaction is completed first.
+ *
+ * @return false if the request could not be sent.
+ */
+bool serial_pipeline_submit(uint8_t transaction_id);
+
+/**
+ * @brief Completes every transaction in flight.
+ *
+ * @return false if any of them failed.
+ */
+bool serial_pipeline_flush(void);
+
+/**
+ * @brief Sends a transaction and waits for it and everything queued before it.
+ *
+ * @return bool Indicates success of this transaction.
+ */
+bool serial_pipeline_transaction(uint8_t transaction_id);
+
+/**
+ * @brief Number of transactions awaiting their response.
+ */
+uint8_t serial_pipeline_in_flight(void);
+
+/**
+ * @brief Receives, executes and answers a single request on the slave.
+ *
+ * @return false if the request was invalid or the link failed.
+ */
+bool serial_pipeline_react(void);
@@ -7,8 +7,16 @@
 #include "serial_protocol.h"
 #include "synchronization_util.h"
 
+#ifdef SERIAL_PIPELINE_ENABLE
+#    include "serial_pipeline.h"
+
+#    define react_to_transaction serial_pipeline_react
+
+static void async_transaction_done(uint8_t transaction_id, bool success);
+#else
 static inline bool initiate_transaction(uint8_t transaction_id);
 static inline bool react_to_transaction(void);
+#endif
 
 /**
  * @brief This thread runs on the slave and responds to transactions initiated
@@ -43,8 +51,54 @@ void soft_serial_target_init(void) {
  */
 void soft_serial_initiator_init(void) {
     serial_transport_driver_master_init();
+
+#ifdef SERIAL_PIPELINE_ENABLE
+    for (uint8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        serial_pipeline_register_callback(id, async_transaction_done);
+    }
+#endif
 }
 
+#ifdef SERIAL_PIPELINE_ENABLE
+/* Set when a transaction that nobody waited for has failed, reported by the
+ * next call to soft_serial_transaction_async. */
+static bool async_transaction_failed = false;
+
+static void async_transaction_done(uint8_t transaction_id, bool success) {
+    if (!success) {
+        serial_dprintf("SPLIT: transaction %u failed\n", transaction_id);
+        async_transaction_failed = true;
+    }
+}
+
+/**
+ * @brief Start transaction from the master half to the slave half and wait
+ * for its response, along with any transaction queued before it.
+ *
+ * @param index Transaction Table index of the transaction to start.
+ * @return bool Indicates success of transaction.
+ */
+bool soft_serial_transaction(int index) {
+    /* A failure of anything queued before fails this transaction as well. */
+    bool success             = serial_pipeline_transaction((uint8_t)index);
+    async_transaction_failed = false;
+    return success;
+}
+
+/**
+ * @brief Queue a transaction from the master half to the slave half without
+ * waiting for the slave's response.
+ *
+ * @param index Transaction Table index of the transaction to start.
+ * @return bool false if the transaction could not be sent, or an earlier one
+ * has failed since the last call.
+ */
+bool soft_serial_transaction_async(int index) {
+    bool success             = serial_pipeline_submit((uint8_t)index) && !async_transaction_failed;
+    async_transaction_failed = false;
+    return success;
+}
+#else
 /**
  * @brief React to transactions started by the master.
  */
@@ -156,3 +210,4 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
 
     return true;
 }
+#endif
@@ -26,6 +26,50 @@ static pin_t currentSlavePin;
 
 static SPIConfig spiConfig;
 
+// Set when spi_stop() was called while an asynchronous transfer was still on the wire
+static volatile bool spiStopPending = false;
+
+/**
+ * Completion hook of every transfer. If the bus was stopped while the last
+ * asynchronous transfer was in flight, the chip select is released here so
+ * that the caller did not have to wait for it.
+ */
+static void spi_end_cb(SPIDriver *spip) {
+    if (spiStopPending) {
+#if SPI_SELECT_MODE == SPI_SELECT_MODE_NONE
+        if (currentSlavePin != NO_PIN) {
+            gpio_write_pin_high(currentSlavePin);
+        }
+#endif
+        osalSysLockFromISR();
+        spiUnselectI(spip);
+        osalSysUnlockFromISR();
+    }
+}
+
+/**
+ * Blocks until the transfer started by spi_transmit_async() has completed.
+ */
+void spi_transmit_wait(void) {
+    osalSysLock();
+    if (SPI_DRIVER.state == SPI_ACTIVE) {
+        osalThreadSuspendS(&SPI_DRIVER.thread);
+    }
+    osalSysUnlock();
+}
+
+/**
+ * Finishes a spi_stop() which was deferred until the last transfer completed.
+ */
+static void spi_complete_stop(void) {
+    spi_transmit_wait();
+    if (spiStopPending) {
+        spiStopPending = false;
+        spiStop(&SPI_DRIVER);
+        spiStarted = false;
+    }
+}
+
 __attribute__((weak)) void spi_init(void) {
     static bool is_initialised = false;
     if (!is_initialised) {
@@ -64,6 +108,7 @@ __attribute__((weak)) void spi_init(void) {
 }
 
 bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
+    spi_complete_stop();
     if (spiStarted) {
         return false;
     }
@@ -280,6 +325,7 @@ bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
 #    error "Unsupported SPI_SELECT_MODE"
 #endif
 
+    spiConfig.end_cb = spi_end_cb;
     spiStart(&SPI_DRIVER, &spiConfig);
     spiSelect(&SPI_DRIVER);
 #if SPI_SELECT_MODE == SPI_SELECT_MODE_NONE
@@ -293,6 +339,7 @@ bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
 
 spi_status_t spi_write(uint8_t data) {
     uint8_t rxData;
+    spi_transmit_wait();
     spiExchange(&SPI_DRIVER, 1, &data, &rxData);
 
     return rxData;
@@ -300,23 +347,41 @@ spi_status_t spi_write(uint8_t data) {
 
 spi_status_t spi_read(void) {
     uint8_t data = 0;
+    spi_transmit_wait();
     spiReceive(&SPI_DRIVER, 1, &data);
 
     return data;
 }
 
 spi_status_t spi_transmit(const uint8_t *data, uint16_t length) {
+    spi_transmit_wait();
     spiSend(&SPI_DRIVER, length, data);
     return SPI_STATUS_SUCCESS;
 }
 
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length) {
+    spi_transmit_wait();
+    spiStartSend(&SPI_DRIVER, length, data);
+    return SPI_STATUS_SUCCESS;
+}
+
 spi_status_t spi_receive(uint8_t *data, uint16_t length) {
+    spi_transmit_wait();
     spiReceive(&SPI_DRIVER, length, data);
     return SPI_STATUS_SUCCESS;
 }
 
 void spi_stop(void) {
-    if (spiStarted) {
+    if (spiStarted && !spiStopPending) {
+        osalSysLock();
+        if (SPI_DRIVER.state == SPI_ACTIVE) {
+            // Leave the last transfer running, spi_end_cb() releases the chip select
+            spiStopPending = true;
+            osalSysUnlock();
+            return;
+        }
+        osalSysUnlock();
+
 #if SPI_SELECT_MODE == SPI_SELECT_MODE_NONE
         if (currentSlavePin != NO_PIN) {
             gpio_write_pin_high(currentSlavePin);
@@ -1,4 +1,5 @@
 #include "ws2812.h"
+#include "ws2812_spi_encode.h"
 #include "gpio.h"
 #include "util.h"
 #include "chibios_config.h"
@@ -75,67 +76,49 @@
 #    define WS2812_SCK_OUTPUT_MODE PAL_MODE_ALTERNATE(WS2812_SPI_SCK_PAL_MODE) | PAL_OUTPUT_TYPE_PUSHPULL
 #endif
 
-#define BYTES_FOR_LED_BYTE 4
 #ifdef RGBW
 #    define WS2812_CHANNELS 4
 #else
 #    define WS2812_CHANNELS 3
 #endif
-#define BYTES_FOR_LED (BYTES_FOR_LED_BYTE * WS2812_CHANNELS)
+#define BYTES_FOR_LED (WS2812_SPI_BYTES_PER_BYTE * WS2812_CHANNELS)
 #define DATA_SIZE (BYTES_FOR_LED * WS2812_LED_COUNT)
 #define RESET_SIZE (1000 * WS2812_TRST_US / (2 * WS2812_TIMING))
 #define PREAMBLE_SIZE 4
 
-static uint8_t txbuf[PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
+// With two buffers, the next frame is encoded into one buffer while the other
+// is on the wire. A circular or synchronous transfer has no time to overlap with.
+#ifndef WS2812_SPI_BUFFER_COUNT
+#    define WS2812_SPI_BUFFER_COUNT 1
+#endif
+#if WS2812_SPI_BUFFER_COUNT != 1 && WS2812_SPI_BUFFER_COUNT != 2
+#    error "WS2812_SPI_BUFFER_COUNT must be 1 or 2."
+#elif WS2812_SPI_BUFFER_COUNT == 2 && (defined(WS2812_SPI_USE_CIRCULAR_BUFFER) || defined(WS2812_SPI_SYNC))
+#    error "WS2812_SPI_BUFFER_COUNT 2 can't be used with WS2812_SPI_USE_CIRCULAR_BUFFER or WS2812_SPI_SYNC."
+#endif
+
+static uint8_t txbuf[WS2812_SPI_BUFFER_COUNT][PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
+
+// Index of the buffer which is not on the wire
+static uint8_t back_buffer = 0;
 
+#if !defined(WS2812_SPI_USE_CIRCULAR_BUFFER) && !defined(WS2812_SPI_SYNC)
 /*
- * As the trick here is to use the SPI to send a huge pattern of 0 and 1 to
- * the ws2812b protocol, we use this helper function to translate bytes into
- * 0s and 1s for the LED (with the appropriate timing).
+ * Waits for the frame on the wire to finish, after which its buffer can be
+ * encoded into again.
  */
-static uint8_t get_protocol_eq(uint8_t data, int pos) {
-    uint8_t eq = 0;
-    if (data & (1 << (2 * (3 - pos))))
-        eq = 0b1110;
-    else
-        eq = 0b1000;
-    if (data & (2 << (2 * (3 - pos))))
-        eq += 0b11100000;
-    else
-        eq += 0b10000000;
-    return eq;
+static void ws2812_spi_wait(void) {
+    osalSysLock();
+    if (WS2812_SPI_DRIVER.state == SPI_ACTIVE) {
+#    ifndef HAL_LLD_SELECT_SPI_V2
+        osalThreadSuspendS(&WS2812_SPI_DRIVER.thread);
+#    else
+        osalThreadSuspendS(&WS2812_SPI_DRIVER.sync_transfer);
+#    endif
+    }
+    osalSysUnlock();
 }
-
-static void set_led_color_rgb(rgb_led_t color, int pos) {
-    uint8_t* tx_start = &txbuf[PREAMBLE_SIZE];
-
-#if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
-#elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_RGB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
-#elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_BGR)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.b, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.r, j);
-#endif
-#ifdef RGBW
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 4 + j] = get_protocol_eq(color.w, j);
 #endif
-}
 
 void ws2812_init(void) {
     palSetLineMode(WS2812_DI_PIN, WS2812_MOSI_OUTPUT_MODE);
@@ -183,7 +166,7 @@ void ws2812_init(void) {
     spiStart(&WS2812_SPI_DRIVER, &spicfg); /* Setup transfer parameters.       */
     spiSelect(&WS2812_SPI_DRIVER);         /* Slave Select assertion.          */
 #ifdef WS2812_SPI_USE_CIRCULAR_BUFFER
-    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+    spiStartSend(&WS2812_SPI_DRIVER, sizeof(txbuf[0]), txbuf[0]);
 #endif
 }
 
@@ -194,17 +177,25 @@ void ws2812_setleds(rgb_led_t* ledarray, uint16_t leds) {
         s_init = true;
     }
 
-    for (uint8_t i = 0; i < leds; i++) {
-        set_led_color_rgb(ledarray[i], i);
-    }
+#if WS2812_SPI_BUFFER_COUNT == 1 && !defined(WS2812_SPI_USE_CIRCULAR_BUFFER) && !defined(WS2812_SPI_SYNC)
+    // The only buffer may still be on the wire
+    ws2812_spi_wait();
+#endif
+
+    // With two buffers, encoding overlaps with the transfer of the previous frame from the other buffer
+    ws2812_spi_encode(&txbuf[back_buffer][PREAMBLE_SIZE], ledarray, leds);
 
-    // Send async - each led takes ~0.03ms, 50 leds ~1.5ms, animations flushing faster than send will cause issues.
-    // Instead spiSend can be used to send synchronously (or the thread logic can be added back).
+    // Send async - each led takes ~0.03ms, 50 leds ~1.5ms. Animations flushing faster than that wait for the previous
+    // frame to finish. Instead spiSend can be used to send synchronously.
 #ifndef WS2812_SPI_USE_CIRCULAR_BUFFER
 #    ifdef WS2812_SPI_SYNC
-    spiSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+    spiSend(&WS2812_SPI_DRIVER, sizeof(txbuf[0]), txbuf[0]);
 #    else
-    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+#        if WS2812_SPI_BUFFER_COUNT == 2
+    ws2812_spi_wait();
+#        endif
+    spiStartSend(&WS2812_SPI_DRIVER, sizeof(txbuf[0]), txbuf[back_buffer]);
+    back_buffer = (back_buffer + 1) % WS2812_SPI_BUFFER_COUNT;
 #    endif
 #endif
 }
@@ -0,0 +1,40 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include "color.h"
+
+/* Every SPI byte carries two WS2812 bits, most significant first. A bit is
+ * sent as a 4 bit pattern: 0b1000 for a 0, and 0b1110 for a 1. */
+#define WS2812_SPI_BYTES_PER_BYTE 4
+
+static const uint8_t ws2812_spi_lut[4] = {0x88, 0x8E, 0xE8, 0xEE};
+
+/**
+ * @brief Encodes one color byte into WS2812_SPI_BYTES_PER_BYTE SPI bytes.
+ */
+static inline void ws2812_spi_encode_byte(uint8_t *dest, uint8_t data) {
+    dest[0] = ws2812_spi_lut[data >> 6];
+    dest[1] = ws2812_spi_lut[(data >> 4) & 3];
+    dest[2] = ws2812_spi_lut[(data >> 2) & 3];
+    dest[3] = ws2812_spi_lut[data & 3];
+}
+
+/**
+ * @brief Encodes a frame of LEDs into dest, which must hold
+ * count * sizeof(rgb_led_t) * WS2812_SPI_BYTES_PER_BYTE bytes.
+ *
+ * The channels of rgb_led_t are already laid out in WS2812_BYTE_ORDER, so
+ * the LEDs are encoded byte by byte in memory order.
+ */
+static inline void ws2812_spi_encode(uint8_t *dest, const rgb_led_t *leds, uint16_t count) {
+    const uint8_t *src = (const uint8_t *)leds;
+    for (uint16_t i = 0; i < count; i++) {
+        for (uint8_t j = 0; j < sizeof(rgb_led_t); j++) {
+            ws2812_spi_encode_byte(dest, *src++);
+            dest += WS2812_SPI_BYTES_PER_BYTE;
+        }
+    }
+}
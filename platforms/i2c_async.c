@@ -0,0 +1,135 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "i2c_async.h"
+#include <stddef.h>
+
+_Static_assert(I2C_ASYNC_QUEUE_SIZE > 0 && I2C_ASYNC_QUEUE_SIZE <= 128 && (I2C_ASYNC_QUEUE_SIZE & (I2C_ASYNC_QUEUE_SIZE - 1)) == 0, "I2C_ASYNC_QUEUE_SIZE must be a power of two, up to 128");
+
+/* Free running indices into the queue. Transactions in [head, run) have been
+ * executed and wait for their callback, [run, tail) still have to be executed.
+ * The main loop owns head and tail, the backend owns run, so the backend can
+ * execute transactions from another thread without a lock. */
+static i2c_async_transaction_t queue[I2C_ASYNC_QUEUE_SIZE];
+static uint8_t                 head;
+static uint8_t                 run;
+static uint8_t                 tail;
+
+#define slot(index) (&queue[(uint8_t)(index) % I2C_ASYNC_QUEUE_SIZE])
+#define load(index) __atomic_load_n(&(index), __ATOMIC_ACQUIRE)
+#define store(index, value) __atomic_store_n(&(index), (value), __ATOMIC_RELEASE)
+
+bool i2c_async_submit(const i2c_async_transaction_t *transaction) {
+    if ((uint8_t)(tail - head) >= I2C_ASYNC_QUEUE_SIZE) {
+        return false;
+    }
+    if ((transaction->op == I2C_ASYNC_WRITE_REGISTER || transaction->op == I2C_ASYNC_WRITE_REGISTER16) && transaction->length > I2C_ASYNC_MAX_WRITE_REGISTER_LENGTH) {
+        return false;
+    }
+
+    *slot(tail)        = *transaction;
+    slot(tail)->status = I2C_STATUS_SUCCESS;
+    store(tail, (uint8_t)(tail + 1));
+
+    i2c_async_backend_notify();
+    return true;
+}
+
+static bool i2c_async_submit_op(i2c_async_op_t op, uint8_t address, uint16_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void *cb_arg) {
+    i2c_async_transaction_t transaction = {
+        .op       = op,
+        .address  = address,
+        .regaddr  = regaddr,
+        .data     = data,
+        .length   = length,
+        .timeout  = timeout,
+        .callback = callback,
+        .cb_arg   = cb_arg,
+    };
+    return i2c_async_submit(&transaction);
+}
+
+bool i2c_async_transmit(uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void *cb_arg) {
+    return i2c_async_submit_op(I2C_ASYNC_TRANSMIT, address, 0, (uint8_t *)data, length, timeout, callback, cb_arg);
+}
+
+bool i2c_async_receive(uint8_t address, uint8_t *data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void *cb_arg) {
+    return i2c_async_submit_op(I2C_ASYNC_RECEIVE, address, 0, data, length, timeout, callback, cb_arg);
+}
+
+bool i2c_async_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void *cb_arg) {
+    return i2c_async_submit_op(I2C_ASYNC_WRITE_REGISTER, devaddr, regaddr, (uint8_t *)data, length, timeout, callback, cb_arg);
+}
+
+bool i2c_async_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void *cb_arg) {
+    return i2c_async_submit_op(I2C_ASYNC_READ_REGISTER, devaddr, regaddr, data, length, timeout, callback, cb_arg);
+}
+
+uint8_t i2c_async_pending(void) {
+    return (uint8_t)(tail - head);
+}
+
+void i2c_async_task(void) {
+    i2c_async_backend_task();
+
+    while (head != load(run)) {
+        i2c_async_transaction_t *transaction = slot(head);
+        i2c_async_callback_t     callback    = transaction->callback;
+        void                    *cb_arg      = transaction->cb_arg;
+        i2c_status_t             status      = transaction->status;
+
+        // Free the slot first, so the callback can queue the next transaction
+        store(head, (uint8_t)(head + 1));
+        if (callback) {
+            callback(status, cb_arg);
+        }
+    }
+}
+
+void i2c_async_flush(void) {
+    while (true) {
+        i2c_async_task();
+        if (!i2c_async_pending()) {
+            break;
+        }
+        i2c_async_backend_wait();
+    }
+}
+
+i2c_async_transaction_t *i2c_async_backend_next(void) {
+    return run != load(tail) ? slot(run) : NULL;
+}
+
+void i2c_async_backend_done(i2c_status_t status) {
+    slot(run)->status = status;
+    store(run, (uint8_t)(run + 1));
+}
+
+i2c_status_t i2c_async_execute(const i2c_async_transaction_t *transaction) {
+    switch (transaction->op) {
+        case I2C_ASYNC_TRANSMIT:
+            return i2c_transmit(transaction->address, transaction->data, transaction->length, transaction->timeout);
+        case I2C_ASYNC_RECEIVE:
+            return i2c_receive(transaction->address, transaction->data, transaction->length, transaction->timeout);
+        case I2C_ASYNC_WRITE_REGISTER:
+            return i2c_write_register(transaction->address, transaction->regaddr, transaction->data, transaction->length, transaction->timeout);
+        case I2C_ASYNC_WRITE_REGISTER16:
+            return i2c_write_register16(transaction->address, transaction->regaddr, transaction->data, transaction->length, transaction->timeout);
+        case I2C_ASYNC_READ_REGISTER:
+            return i2c_read_register(transaction->address, transaction->regaddr, transaction->data, transaction->length, transaction->timeout);
+        case I2C_ASYNC_READ_REGISTER16:
+            return i2c_read_register16(transaction->address, transaction->regaddr, transaction->data, transaction->length, transaction->timeout);
+    }
+    return I2C_STATUS_ERROR;
+}
+
+__attribute__((weak)) void i2c_async_backend_notify(void) {}
+
+__attribute__((weak)) void i2c_async_backend_task(void) {
+    i2c_async_transaction_t *transaction;
+    while ((transaction = i2c_async_backend_next()) != NULL) {
+        i2c_async_backend_done(i2c_async_execute(transaction));
+    }
+}
+
+__attribute__((weak)) void i2c_async_backend_wait(void) {}
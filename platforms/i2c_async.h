@@ -0,0 +1,108 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/* Queued I2C transactions, so that LED drivers and sensors don't stall the
+ * matrix scan while a frame is on the bus.
+ *
+ * Transactions are submitted from the main loop and executed in order by a
+ * platform backend. On ChibiOS a worker thread runs them, elsewhere they run
+ * synchronously from i2c_async_task(). Completion callbacks are always invoked
+ * from i2c_async_task() in the main loop, in submission order.
+ *
+ * Any buffer referenced by a transaction has to stay valid until its callback
+ * has been invoked.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "i2c_master.h"
+
+/**
+ * @def I2C_ASYNC_QUEUE_SIZE
+ * @brief Number of transactions that can be queued at once, must be a power of two.
+ */
+#ifndef I2C_ASYNC_QUEUE_SIZE
+#    define I2C_ASYNC_QUEUE_SIZE 8
+#endif
+
+/**
+ * @def I2C_ASYNC_MAX_WRITE_REGISTER_LENGTH
+ * @brief Longest register write that can be queued. The blocking API copies
+ * register writes to the stack, so this sizes the stack of the worker thread.
+ */
+#ifndef I2C_ASYNC_MAX_WRITE_REGISTER_LENGTH
+#    define I2C_ASYNC_MAX_WRITE_REGISTER_LENGTH 192
+#endif
+
+typedef enum {
+    I2C_ASYNC_TRANSMIT,
+    I2C_ASYNC_RECEIVE,
+    I2C_ASYNC_WRITE_REGISTER,
+    I2C_ASYNC_WRITE_REGISTER16,
+    I2C_ASYNC_READ_REGISTER,
+    I2C_ASYNC_READ_REGISTER16,
+} i2c_async_op_t;
+
+typedef void (*i2c_async_callback_t)(i2c_status_t status, void *cb_arg);
+
+typedef struct {
+    i2c_async_op_t       op;
+    uint8_t              address;
+    uint16_t             regaddr;
+    uint8_t             *data;
+    uint16_t             length;
+    uint16_t             timeout;
+    i2c_async_callback_t callback; // optional
+    void                *cb_arg;
+    i2c_status_t         status;
+} i2c_async_transaction_t;
+
+/**
+ * @brief Queues a copy of the transaction.
+ *
+ * @return false if the queue is full, or a register write is longer than I2C_ASYNC_MAX_WRITE_REGISTER_LENGTH
+ */
+bool i2c_async_submit(const i2c_async_transaction_t *transaction);
+
+bool i2c_async_transmit(uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void *cb_arg);
+bool i2c_async_receive(uint8_t address, uint8_t *data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void *cb_arg);
+bool i2c_async_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void *cb_arg);
+bool i2c_async_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void *cb_arg);
+
+/**
+ * @brief Number of transactions that have been submitted but whose callback has not been invoked yet.
+ */
+uint8_t i2c_async_pending(void);
+
+/**
+ * @brief Blocks until every queued transaction has completed and its callback has been invoked.
+ */
+void i2c_async_flush(void);
+
+/**
+ * @brief Invokes the callbacks of completed transactions. Called from the main loop.
+ */
+void i2c_async_task(void);
+
+/* Backend interface. The weak defaults execute queued transactions
+ * synchronously from i2c_async_task(). */
+
+/**
+ * @brief Returns the oldest transaction that has not been executed yet, or NULL.
+ */
+i2c_async_transaction_t *i2c_async_backend_next(void);
+
+/**
+ * @brief Completes the transaction returned by i2c_async_backend_next().
+ */
+void i2c_async_backend_done(i2c_status_t status);
+
+/**
+ * @brief Runs a transaction with the blocking i2c_master API.
+ */
+i2c_status_t i2c_async_execute(const i2c_async_transaction_t *transaction);
+
+void i2c_async_backend_notify(void);
+void i2c_async_backend_task(void);
+void i2c_async_backend_wait(void);
@@ -0,0 +1,201 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "i2c_async.h"
+#include "i2c_master_mock.h"
+#include "timer.h"
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+#define DEVICE_A (0x30 << 1)
+#define DEVICE_B (0x74 << 1)
+
+/* At 400kHz a 144 byte LED frame written to a register takes
+ * (2 + 144) * 9 + 2 bits, or 4ms on the bus. */
+#define FRAME_SIZE 144
+#define FRAME_TIME 4
+
+class I2CAsync : public ::testing::Test {
+   protected:
+    struct Completion {
+        i2c_status_t status;
+        int          id;
+        uint32_t     time;
+    };
+
+    static std::vector<Completion> completions;
+
+    static void record(i2c_status_t status, void *cb_arg) {
+        completions.push_back({status, (int)(intptr_t)cb_arg, timer_read32()});
+    }
+
+    void SetUp() override {
+        set_time(0);
+        i2c_mock_reset(400000);
+        completions.clear();
+    }
+
+    void TearDown() override {
+        i2c_async_flush();
+        EXPECT_EQ(i2c_async_pending(), 0);
+    }
+
+    bool write_frame(uint8_t address, int id) {
+        return i2c_async_write_register(address, 0x00, frame, sizeof(frame), 100, record, (void *)(intptr_t)id);
+    }
+
+    uint8_t frame[FRAME_SIZE] = {0};
+};
+
+std::vector<I2CAsync::Completion> I2CAsync::completions;
+
+TEST_F(I2CAsync, FrameTimeMatchesBusClock) {
+    EXPECT_EQ(i2c_mock_transfer_time(2 + FRAME_SIZE), FRAME_TIME);
+}
+
+TEST_F(I2CAsync, BlockingWriteStallsCaller) {
+    EXPECT_EQ(i2c_write_register(DEVICE_A, 0x00, frame, sizeof(frame), 100), I2C_STATUS_SUCCESS);
+    EXPECT_EQ(timer_read32(), FRAME_TIME);
+}
+
+TEST_F(I2CAsync, SubmitDoesNotBlock) {
+    EXPECT_TRUE(write_frame(DEVICE_A, 0));
+    EXPECT_TRUE(write_frame(DEVICE_B, 1));
+    i2c_async_task();
+
+    EXPECT_EQ(timer_read32(), 0);
+    EXPECT_EQ(i2c_async_pending(), 2);
+    EXPECT_TRUE(completions.empty());
+}
+
+TEST_F(I2CAsync, CallbacksRunInOrderAtCompletionTime) {
+    for (int i = 0; i < 3; i++) {
+        EXPECT_TRUE(write_frame(i % 2 ? DEVICE_B : DEVICE_A, i));
+    }
+
+    for (uint32_t t = 0; t < 3 * FRAME_TIME + 2; t++) {
+        i2c_async_task();
+        advance_time(1);
+    }
+
+    ASSERT_EQ(completions.size(), 3);
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(completions[i].id, i);
+        EXPECT_EQ(completions[i].status, I2C_STATUS_SUCCESS);
+        EXPECT_EQ(completions[i].time, (uint32_t)(i + 1) * FRAME_TIME);
+    }
+
+    // The transactions were back to back on the bus
+    ASSERT_EQ(i2c_mock_transfer_count(), 3);
+    for (int i = 1; i < 3; i++) {
+        EXPECT_EQ(i2c_mock_transfer(i)->start, i2c_mock_transfer(i - 1)->end);
+    }
+}
+
+TEST_F(I2CAsync, ScanLoopKeepsRunningDuringTransfers) {
+    // One LED frame per device, submitted from a 1ms scan loop which never waits for the bus
+    EXPECT_TRUE(write_frame(DEVICE_A, 0));
+    EXPECT_TRUE(write_frame(DEVICE_B, 1));
+
+    uint32_t scans = 0;
+    while (completions.size() < 2) {
+        i2c_async_task();
+        advance_time(1);
+        scans++;
+    }
+
+    EXPECT_EQ(scans, 2 * FRAME_TIME + 1);
+    EXPECT_EQ(completions.back().time, 2 * FRAME_TIME);
+}
+
+TEST_F(I2CAsync, FullQueueRejectsSubmissions) {
+    for (int i = 0; i < I2C_ASYNC_QUEUE_SIZE; i++) {
+        EXPECT_TRUE(write_frame(DEVICE_A, i));
+    }
+    EXPECT_FALSE(write_frame(DEVICE_A, I2C_ASYNC_QUEUE_SIZE));
+    EXPECT_EQ(i2c_async_pending(), I2C_ASYNC_QUEUE_SIZE);
+
+    // Completing a transaction frees its slot
+    advance_time(FRAME_TIME);
+    i2c_async_task();
+    ASSERT_EQ(completions.size(), 1);
+    EXPECT_TRUE(write_frame(DEVICE_A, I2C_ASYNC_QUEUE_SIZE));
+    EXPECT_FALSE(write_frame(DEVICE_A, I2C_ASYNC_QUEUE_SIZE + 1));
+}
+
+TEST_F(I2CAsync, LongRegisterWriteIsRejected) {
+    static_assert(FRAME_SIZE <= I2C_ASYNC_MAX_WRITE_REGISTER_LENGTH, "frames have to fit");
+    static uint8_t long_frame[I2C_ASYNC_MAX_WRITE_REGISTER_LENGTH + 1];
+
+    EXPECT_TRUE(i2c_async_write_register(DEVICE_A, 0x00, long_frame, I2C_ASYNC_MAX_WRITE_REGISTER_LENGTH, 100, record, (void *)0));
+    EXPECT_FALSE(i2c_async_write_register(DEVICE_A, 0x00, long_frame, sizeof(long_frame), 100, record, (void *)1));
+
+    i2c_async_transaction_t transaction = {.op = I2C_ASYNC_WRITE_REGISTER16, .address = DEVICE_A, .data = long_frame, .length = sizeof(long_frame), .timeout = 100};
+    EXPECT_FALSE(i2c_async_submit(&transaction));
+
+    // Plain transmits aren't copied
+    EXPECT_TRUE(i2c_async_transmit(DEVICE_A, long_frame, sizeof(long_frame), 100, record, (void *)2));
+    EXPECT_EQ(i2c_async_pending(), 2);
+}
+
+TEST_F(I2CAsync, CallbackCanResubmit) {
+    // Chain frames from the completion callback, as an LED driver refreshing continuously would
+    struct Chain {
+        static void next_frame(i2c_status_t status, void *cb_arg) {
+            static uint8_t buffer[FRAME_SIZE];
+            intptr_t       count = (intptr_t)cb_arg;
+            record(status, cb_arg);
+            if (++count < 5) {
+                EXPECT_TRUE(i2c_async_write_register(DEVICE_A, 0x00, buffer, sizeof(buffer), 100, next_frame, (void *)count));
+            }
+        }
+    };
+    EXPECT_TRUE(i2c_async_write_register(DEVICE_A, 0x00, frame, sizeof(frame), 100, Chain::next_frame, (void *)(intptr_t)0));
+    i2c_async_flush();
+
+    ASSERT_EQ(completions.size(), 5);
+    EXPECT_EQ(completions.back().id, 4);
+    EXPECT_EQ(completions.back().time, 5 * FRAME_TIME);
+}
+
+TEST_F(I2CAsync, FlushWaitsForAllTransactions) {
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(write_frame(DEVICE_A, i));
+    }
+    i2c_async_flush();
+
+    EXPECT_EQ(i2c_async_pending(), 0);
+    EXPECT_EQ(completions.size(), 4);
+    EXPECT_EQ(timer_read32(), 4 * FRAME_TIME);
+}
+
+TEST_F(I2CAsync, ReadCompletesWithData) {
+    uint8_t data[4] = {0};
+    EXPECT_TRUE(i2c_async_read_register(DEVICE_B, 0x10, data, sizeof(data), 100, record, (void *)(intptr_t)7));
+    i2c_async_flush();
+
+    ASSERT_EQ(completions.size(), 1);
+    EXPECT_EQ(completions[0].id, 7);
+    EXPECT_EQ(completions[0].status, I2C_STATUS_SUCCESS);
+    for (uint8_t i = 0; i < sizeof(data); i++) {
+        EXPECT_EQ(data[i], 0x10 + i);
+    }
+}
+
+TEST_F(I2CAsync, ErrorStatusIsPropagated) {
+    i2c_mock_set_nack(DEVICE_B, true);
+    EXPECT_TRUE(write_frame(DEVICE_A, 0));
+    EXPECT_TRUE(write_frame(DEVICE_B, 1));
+    EXPECT_TRUE(write_frame(DEVICE_A, 2));
+    i2c_async_flush();
+
+    ASSERT_EQ(completions.size(), 3);
+    EXPECT_EQ(completions[0].status, I2C_STATUS_SUCCESS);
+    EXPECT_EQ(completions[1].status, I2C_STATUS_ERROR);
+    EXPECT_EQ(completions[2].status, I2C_STATUS_SUCCESS);
+}
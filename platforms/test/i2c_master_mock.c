@@ -0,0 +1,138 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "i2c_master_mock.h"
+#include "i2c_async.h"
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+
+static uint32_t            clock_hz = 400000;
+static bool                nack[128];
+static i2c_mock_transfer_t transfers[I2C_MOCK_MAX_TRANSFERS];
+static uint16_t            transfer_count;
+static uint32_t            bus_free_at;
+static bool                in_backend;
+static uint32_t            backend_now;
+
+static bool         active;
+static uint32_t     active_end;
+static i2c_status_t active_status;
+
+void i2c_mock_reset(uint32_t clock) {
+    clock_hz       = clock;
+    transfer_count = 0;
+    bus_free_at    = timer_read32();
+    active         = false;
+    memset(nack, 0, sizeof(nack));
+}
+
+void i2c_mock_set_nack(uint8_t address, bool value) {
+    nack[address >> 1] = value;
+}
+
+uint32_t i2c_mock_transfer_time(uint16_t bytes) {
+    // 9 clocks per byte including the ack, plus start and stop conditions
+    uint32_t bits = bytes * 9 + 2;
+    return (bits * 1000 + clock_hz - 1) / clock_hz;
+}
+
+uint16_t i2c_mock_transfer_count(void) {
+    return transfer_count;
+}
+
+const i2c_mock_transfer_t *i2c_mock_transfer(uint16_t index) {
+    return index < transfer_count ? &transfers[index] : NULL;
+}
+
+static i2c_status_t mock_transfer(uint8_t address, uint16_t bytes) {
+    uint32_t now   = in_backend ? backend_now : timer_read32();
+    uint32_t start = (int32_t)(bus_free_at - now) > 0 ? bus_free_at : now;
+    bus_free_at    = start + i2c_mock_transfer_time(bytes);
+
+    if (transfer_count < I2C_MOCK_MAX_TRANSFERS) {
+        transfers[transfer_count++] = (i2c_mock_transfer_t){address, bytes, start, bus_free_at};
+    }
+    if (!in_backend) {
+        // A blocking caller stalls until the transfer is done
+        advance_time(bus_free_at - now);
+    }
+    return nack[address >> 1] ? I2C_STATUS_ERROR : I2C_STATUS_SUCCESS;
+}
+
+static void mock_fill(uint8_t *data, uint16_t length, uint8_t seed) {
+    for (uint16_t i = 0; i < length; i++) {
+        data[i] = seed + i;
+    }
+}
+
+void i2c_init(void) {}
+
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout) {
+    return mock_transfer(address, 1 + length);
+}
+
+i2c_status_t i2c_receive(uint8_t address, uint8_t *data, uint16_t length, uint16_t timeout) {
+    mock_fill(data, length, address);
+    return mock_transfer(address, 1 + length);
+}
+
+i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout) {
+    return mock_transfer(devaddr, 2 + length);
+}
+
+i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout) {
+    return mock_transfer(devaddr, 3 + length);
+}
+
+i2c_status_t i2c_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout) {
+    mock_fill(data, length, regaddr);
+    return mock_transfer(devaddr, 3 + length);
+}
+
+i2c_status_t i2c_read_register16(uint8_t devaddr, uint16_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout) {
+    mock_fill(data, length, regaddr);
+    return mock_transfer(devaddr, 4 + length);
+}
+
+i2c_status_t i2c_ping_address(uint8_t address, uint16_t timeout) {
+    return mock_transfer(address, 1);
+}
+
+/* Asynchronous backend, a transaction occupies the bus from the moment it is
+ * started until its simulated end. Completion is only observed once the test
+ * has advanced the time past that end. */
+static void backend_start_next(uint32_t now) {
+    i2c_async_transaction_t *transaction = i2c_async_backend_next();
+    if (active || !transaction) {
+        return;
+    }
+
+    backend_now   = now;
+    in_backend    = true;
+    active_status = i2c_async_execute(transaction);
+    in_backend    = false;
+    active_end    = bus_free_at;
+    active        = true;
+}
+
+void i2c_async_backend_notify(void) {
+    backend_start_next(timer_read32());
+}
+
+void i2c_async_backend_task(void) {
+    while (active && (int32_t)(timer_read32() - active_end) >= 0) {
+        active = false;
+        i2c_async_backend_done(active_status);
+        // Like a worker thread, the next transaction starts as soon as the bus is free
+        backend_start_next(active_end);
+    }
+}
+
+void i2c_async_backend_wait(void) {
+    uint32_t now = timer_read32();
+    if (active && (int32_t)(active_end - now) > 0) {
+        advance_time(active_end - now);
+    }
+}
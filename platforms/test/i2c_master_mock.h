@@ -0,0 +1,27 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/* Host mock of the I2C master driver which simulates bus timing against the
+ * test timer. Blocking calls advance the time by the duration of the transfer,
+ * the asynchronous backend completes transactions once the time has been
+ * advanced past their end. */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "i2c_master.h"
+
+#define I2C_MOCK_MAX_TRANSFERS 64
+
+typedef struct {
+    uint8_t  address;
+    uint16_t bytes; // bytes on the wire, including addresses and register addresses
+    uint32_t start;
+    uint32_t end;
+} i2c_mock_transfer_t;
+
+void                       i2c_mock_reset(uint32_t clock_hz);
+void                       i2c_mock_set_nack(uint8_t address, bool nack);
+uint32_t                   i2c_mock_transfer_time(uint16_t bytes);
+uint16_t                   i2c_mock_transfer_count(void);
+const i2c_mock_transfer_t *i2c_mock_transfer(uint16_t index);
@@ -23,3 +23,36 @@ eeprom_legacy_emulated_flash_SRC := \
 	$(PLATFORM_PATH)/chibios/drivers/eeprom/eeprom_legacy_emulated_flash.c
 eeprom_legacy_emulated_flash_tiny_SRC := $(eeprom_legacy_emulated_flash_SRC)
 eeprom_legacy_emulated_flash_large_SRC := $(eeprom_legacy_emulated_flash_SRC)
+
+i2c_async_DEFS := -DNO_PRINT
+i2c_async_INC := $(PLATFORM_PATH)/chibios/drivers/
+i2c_async_SRC := \
+	$(PLATFORM_PATH)/i2c_async.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/i2c_async_tests.cpp \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/i2c_master_mock.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+serial_pipeline_DEFS := -DNO_PRINT -DMATRIX_ROWS=4 -DMATRIX_COLS=4 -DSPLIT_KEYBOARD -DSERIAL_USART_FULL_DUPLEX -DSPLIT_TRANSACTION_IDS_USER=USER_PING
+serial_pipeline_INC := \
+	$(PLATFORM_PATH)/chibios/drivers/ \
+	$(QUANTUM_PATH)/split_common/
+serial_pipeline_SRC := \
+	$(PLATFORM_PATH)/chibios/drivers/serial_pipeline.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/serial_pipeline_tests.cpp \
+	$(PLATFORM_PATH)/synchronization_util.c \
+	$(QUANTUM_PATH)/crc.c
+
+ws2812_spi_encode_INC := $(PLATFORM_PATH)/chibios/drivers/
+ws2812_spi_encode_SRC := $(PLATFORM_PATH)/$(PLATFORM_KEY)/ws2812_spi_encode_tests.cpp
+
+ws2812_spi_encode_rgbw_DEFS := -DRGBW -DWS2812_BYTE_ORDER=WS2812_BYTE_ORDER_BGR
+ws2812_spi_encode_rgbw_INC := $(ws2812_spi_encode_INC)
+ws2812_spi_encode_rgbw_SRC := $(ws2812_spi_encode_SRC)
+
+usb_report_queue_DEFS := -DMOUSE_ENABLE
+usb_report_queue_INC := $(TMK_PATH)/protocol/chibios/
+usb_report_queue_SRC := $(PLATFORM_PATH)/$(PLATFORM_KEY)/usb_report_queue_tests.cpp
+
+usb_report_queue_extended_DEFS := $(usb_report_queue_DEFS) -DMOUSE_EXTENDED_REPORT
+usb_report_queue_extended_INC := $(usb_report_queue_INC)
+usb_report_queue_extended_SRC := $(usb_report_queue_SRC)
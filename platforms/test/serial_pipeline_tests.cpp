@@ -0,0 +1,291 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+#include "gtest/gtest.h"
+
+// transaction_id_define.h checks the number of transactions with the C keyword
+#define _Static_assert static_assert
+
+extern "C" {
+#include "serial_pipeline.h"
+#include "serial_protocol.h"
+#include "transactions.h"
+}
+
+/* Both halves run in this process over an in-memory loopback link. The slave
+ * only runs when the master has to wait for a response, so the number of times
+ * that happens is the number of link turnarounds the master paid for. */
+
+#define SHMEM_SIZE 64
+#define PING_OFFSET 0
+#define PUT_OFFSET 8
+#define GET_OFFSET 16
+
+static uint8_t master_shmem[SHMEM_SIZE];
+static uint8_t slave_shmem[SHMEM_SIZE];
+
+extern "C" {
+split_transaction_desc_t     split_transaction_table[NUM_TOTAL_TRANSACTIONS];
+split_shared_memory_t *const split_shmem = reinterpret_cast<split_shared_memory_t *>(master_shmem);
+}
+
+static std::deque<uint8_t> master_to_slave;
+static std::deque<uint8_t> slave_to_master;
+static bool                slave_running;
+static int                 turnarounds;
+static std::vector<int>    slave_log;
+
+static void run_slave(void) {
+    // The slave has its own view of the shared memory
+    std::swap_ranges(master_shmem, master_shmem + SHMEM_SIZE, slave_shmem);
+    slave_running = true;
+    while (!master_to_slave.empty()) {
+        if (!serial_pipeline_react()) {
+            serial_transport_driver_clear();
+        }
+    }
+    slave_running = false;
+    std::swap_ranges(master_shmem, master_shmem + SHMEM_SIZE, slave_shmem);
+}
+
+extern "C" {
+void serial_transport_driver_clear(void) {
+    (slave_running ? master_to_slave : slave_to_master).clear();
+}
+
+void serial_transport_driver_slave_init(void) {}
+
+void serial_transport_driver_master_init(void) {}
+
+bool serial_transport_receive(uint8_t *destination, const size_t size) {
+    std::deque<uint8_t> &queue = slave_running ? master_to_slave : slave_to_master;
+    if (!slave_running && queue.size() < size && !master_to_slave.empty()) {
+        turnarounds++;
+        run_slave();
+    }
+
+    // Like a timeout, whatever did arrive is consumed
+    size_t available = std::min(size, queue.size());
+    std::copy_n(queue.begin(), available, destination);
+    queue.erase(queue.begin(), queue.begin() + available);
+    return available == size;
+}
+
+bool serial_transport_receive_blocking(uint8_t *destination, const size_t size) {
+    return serial_transport_receive(destination, size);
+}
+
+bool serial_transport_send(const uint8_t *source, const size_t size) {
+    std::deque<uint8_t> &queue = slave_running ? slave_to_master : master_to_slave;
+    queue.insert(queue.end(), source, source + size);
+    return true;
+}
+}
+
+// Answers with every request byte incremented
+static void ping_handler(uint8_t in_len, const void *in_data, uint8_t out_len, void *out_data) {
+    slave_log.push_back(USER_PING);
+    for (uint8_t i = 0; i < out_len; i++) {
+        ((uint8_t *)out_data)[i] = ((const uint8_t *)in_data)[i] + 1;
+    }
+}
+
+static void put_handler(uint8_t in_len, const void *in_data, uint8_t out_len, void *out_data) {
+    slave_log.push_back(PUT_SYNC_TIMER);
+}
+
+// Reports how many requests the slave has executed
+static void get_handler(uint8_t in_len, const void *in_data, uint8_t out_len, void *out_data) {
+    slave_log.push_back(GET_SLAVE_MATRIX_DATA);
+    memset(out_data, (uint8_t)slave_log.size(), out_len);
+}
+
+class SerialPipeline : public ::testing::Test {
+   protected:
+    struct Completion {
+        uint8_t id;
+        bool    success;
+    };
+
+    static std::vector<Completion> completions;
+
+    static void record(uint8_t transaction_id, bool success) {
+        completions.push_back({transaction_id, success});
+    }
+
+    void SetUp() override {
+        memset(master_shmem, 0, sizeof(master_shmem));
+        memset(slave_shmem, 0, sizeof(slave_shmem));
+        memset(split_transaction_table, 0, sizeof(split_transaction_table));
+        split_transaction_table[USER_PING]             = {4, PING_OFFSET, 4, PING_OFFSET + 4, ping_handler};
+        split_transaction_table[PUT_SYNC_TIMER]        = {8, PUT_OFFSET, 0, 0, put_handler};
+        split_transaction_table[GET_SLAVE_MATRIX_DATA] = {0, 0, 4, GET_OFFSET, get_handler};
+
+        for (uint8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+            serial_pipeline_register_callback(id, record);
+        }
+
+        master_to_slave.clear();
+        slave_to_master.clear();
+        slave_log.clear();
+        completions.clear();
+        turnarounds = 0;
+    }
+
+    void TearDown() override {
+        serial_pipeline_flush();
+        EXPECT_EQ(serial_pipeline_in_flight(), 0);
+    }
+
+    void put(uint8_t value) {
+        memset(&master_shmem[PUT_OFFSET], value, 8);
+        EXPECT_TRUE(serial_pipeline_submit(PUT_SYNC_TIMER));
+    }
+};
+
+std::vector<SerialPipeline::Completion> SerialPipeline::completions;
+
+TEST_F(SerialPipeline, TransactionRoundTrip) {
+    const uint8_t request[4] = {1, 2, 3, 4};
+    memcpy(&master_shmem[PING_OFFSET], request, sizeof(request));
+
+    EXPECT_TRUE(serial_pipeline_transaction(USER_PING));
+    EXPECT_EQ(turnarounds, 1);
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(master_shmem[PING_OFFSET + 4 + i], request[i] + 1);
+        EXPECT_EQ(slave_shmem[PING_OFFSET + i], request[i]);
+    }
+    ASSERT_EQ(completions.size(), 1);
+    EXPECT_EQ(completions[0].id, USER_PING);
+    EXPECT_TRUE(completions[0].success);
+}
+
+TEST_F(SerialPipeline, FramesCarryHeaderAndChecksum) {
+    put(0xAA);
+    // header, 8 data bytes, crc8
+    EXPECT_EQ(master_to_slave.size(), 1 + 8 + 1);
+    EXPECT_EQ(master_to_slave.front() & 0x1F, PUT_SYNC_TIMER);
+}
+
+TEST_F(SerialPipeline, SubmitDoesNotWaitForResponse) {
+    for (int i = 0; i < SERIAL_PIPELINE_DEPTH; i++) {
+        put(i);
+    }
+
+    EXPECT_EQ(serial_pipeline_in_flight(), SERIAL_PIPELINE_DEPTH);
+    EXPECT_EQ(turnarounds, 0);
+    EXPECT_TRUE(slave_log.empty());
+    EXPECT_TRUE(completions.empty());
+}
+
+TEST_F(SerialPipeline, WritesAndReadShareOneTurnaround) {
+    // A scan's worth of state updates followed by the slave matrix read
+    for (int i = 0; i < SERIAL_PIPELINE_DEPTH - 1; i++) {
+        put(i);
+    }
+    EXPECT_TRUE(serial_pipeline_transaction(GET_SLAVE_MATRIX_DATA));
+
+    // The handshake protocol turns the link around twice per transaction
+    EXPECT_EQ(turnarounds, 1);
+    EXPECT_EQ(master_shmem[GET_OFFSET], SERIAL_PIPELINE_DEPTH);
+    EXPECT_EQ(slave_shmem[PUT_OFFSET], SERIAL_PIPELINE_DEPTH - 2);
+
+    // Executed and completed in submission order
+    ASSERT_EQ(slave_log.size(), SERIAL_PIPELINE_DEPTH);
+    ASSERT_EQ(completions.size(), SERIAL_PIPELINE_DEPTH);
+    for (int i = 0; i < SERIAL_PIPELINE_DEPTH; i++) {
+        uint8_t expected = i < SERIAL_PIPELINE_DEPTH - 1 ? PUT_SYNC_TIMER : GET_SLAVE_MATRIX_DATA;
+        EXPECT_EQ(slave_log[i], expected);
+        EXPECT_EQ(completions[i].id, expected);
+        EXPECT_TRUE(completions[i].success);
+    }
+}
+
+TEST_F(SerialPipeline, FullPipelineCompletesOldest) {
+    for (int i = 0; i <= SERIAL_PIPELINE_DEPTH; i++) {
+        put(i);
+    }
+
+    EXPECT_EQ(serial_pipeline_in_flight(), SERIAL_PIPELINE_DEPTH);
+    ASSERT_EQ(completions.size(), 1);
+    EXPECT_TRUE(completions[0].success);
+}
+
+TEST_F(SerialPipeline, CorruptedRequestIsRejected) {
+    put(0x11);
+    EXPECT_TRUE(serial_pipeline_flush());
+
+    put(0x22);
+    put(0x33);
+    master_to_slave[3] ^= 0x40;
+    EXPECT_FALSE(serial_pipeline_flush());
+
+    // The slave never applied the damaged frame, and both transactions failed
+    EXPECT_EQ(slave_shmem[PUT_OFFSET], 0x11);
+    EXPECT_EQ(slave_log.size(), 1);
+    ASSERT_EQ(completions.size(), 3);
+    EXPECT_FALSE(completions[1].success);
+    EXPECT_FALSE(completions[2].success);
+
+    // The link recovers with the next transaction
+    put(0x44);
+    EXPECT_TRUE(serial_pipeline_flush());
+    EXPECT_EQ(slave_shmem[PUT_OFFSET], 0x44);
+}
+
+TEST_F(SerialPipeline, CorruptedResponseIsRejected) {
+    memset(&master_shmem[GET_OFFSET], 0xEE, 4);
+    EXPECT_TRUE(serial_pipeline_submit(GET_SLAVE_MATRIX_DATA));
+    run_slave();
+    slave_to_master[2] ^= 0x01;
+
+    EXPECT_FALSE(serial_pipeline_flush());
+    EXPECT_EQ(master_shmem[GET_OFFSET], 0xEE);
+
+    EXPECT_TRUE(serial_pipeline_transaction(GET_SLAVE_MATRIX_DATA));
+    EXPECT_EQ(master_shmem[GET_OFFSET], 2);
+}
+
+TEST_F(SerialPipeline, LostResponseFailsEverythingInFlight) {
+    put(1);
+    put(2);
+    run_slave();
+    // Drop the first response, the second one is now out of sequence
+    slave_to_master.pop_front();
+    slave_to_master.pop_front();
+
+    EXPECT_FALSE(serial_pipeline_flush());
+    ASSERT_EQ(completions.size(), 2);
+    EXPECT_FALSE(completions[0].success);
+    EXPECT_FALSE(completions[1].success);
+    EXPECT_TRUE(slave_to_master.empty());
+}
+
+TEST_F(SerialPipeline, StaleResponseIsNotAccepted) {
+    // A response from before a resync has the right id but the wrong sequence number
+    put(1);
+    run_slave();
+    std::deque<uint8_t> stale = slave_to_master;
+    EXPECT_TRUE(serial_pipeline_flush());
+
+    put(2);
+    slave_to_master = stale;
+    EXPECT_FALSE(serial_pipeline_flush());
+}
+
+TEST_F(SerialPipeline, SlaveIgnoresUnknownTransactions) {
+    master_to_slave.push_back(NUM_TOTAL_TRANSACTIONS);
+    run_slave();
+    EXPECT_TRUE(slave_log.empty());
+
+    EXPECT_TRUE(serial_pipeline_transaction(USER_PING));
+    EXPECT_EQ(slave_log.size(), 1);
+}
+
+TEST_F(SerialPipeline, InvalidTransactionIdIsRefused) {
+    EXPECT_FALSE(serial_pipeline_submit(NUM_TOTAL_TRANSACTIONS));
+    EXPECT_TRUE(master_to_slave.empty());
+}
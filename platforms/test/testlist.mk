@@ -1 +1 @@
-TEST_LIST += eeprom_legacy_emulated_flash_tiny eeprom_legacy_emulated_flash_large
+TEST_LIST += eeprom_legacy_emulated_flash_tiny eeprom_legacy_emulated_flash_large i2c_async serial_pipeline ws2812_spi_encode ws2812_spi_encode_rgbw usb_report_queue usb_report_queue_extended
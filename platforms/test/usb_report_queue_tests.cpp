@@ -0,0 +1,202 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <utility>
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "usb_report_queue.h"
+}
+
+USB_REPORT_QUEUE(test, 8, false);
+USB_REPORT_QUEUE(shared, 8, true);
+USB_REPORT_QUEUE(mouse, sizeof(report_mouse_t), false);
+
+using shared_report = std::pair<int, int>;
+
+class UsbReportQueue : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        usb_report_queue_reset(&test_report_queue);
+        usb_report_queue_reset(&shared_report_queue);
+        usb_report_queue_reset(&mouse_report_queue);
+    }
+
+    static void push(uint8_t value) {
+        uint8_t report[8] = {value};
+        usb_report_queue_push(&test_report_queue, report, sizeof(report), NULL);
+    }
+
+    static void push_shared(uint8_t report_id, uint8_t value, size_t size = 8) {
+        uint8_t report[8] = {report_id, value};
+        usb_report_queue_push(&shared_report_queue, report, size, NULL);
+    }
+
+    // Starts the next shared transmission and returns the report ID and value
+    static shared_report start_shared() {
+        uint8_t        size   = 0;
+        const uint8_t *report = usb_report_queue_start(&shared_report_queue, &size);
+        return report ? shared_report{report[0], report[1]} : shared_report{-1, -1};
+    }
+
+    // Starts the next transmission and returns the first byte of the report
+    static int start(usb_report_queue_t *queue = &test_report_queue) {
+        uint8_t        size   = 0;
+        const uint8_t *report = usb_report_queue_start(queue, &size);
+        return report ? report[0] : -1;
+    }
+
+    static report_mouse_t mouse(uint8_t buttons, int x, int y) {
+        report_mouse_t report = {};
+        report.buttons        = buttons;
+        report.x              = x;
+        report.y              = y;
+        return report;
+    }
+
+    static void push_mouse(report_mouse_t report) {
+        usb_report_queue_push(&mouse_report_queue, &report, sizeof(report), usb_report_merge_mouse);
+    }
+
+    static const report_mouse_t *mouse_slot(uint8_t index) {
+        return (const report_mouse_t *)usb_report_queue_slot(&mouse_report_queue, mouse_report_queue.head + index);
+    }
+};
+
+TEST_F(UsbReportQueue, SendsInOrder) {
+    for (uint8_t i = 1; i <= 3; i++) {
+        push(i);
+    }
+    for (int i = 1; i <= 3; i++) {
+        EXPECT_EQ(start(), i);
+        EXPECT_EQ(start(), -1) << "only one report may be in flight";
+        usb_report_queue_transmitted(&test_report_queue);
+    }
+    EXPECT_EQ(start(), -1);
+    EXPECT_EQ(test_report_queue.count, 0);
+}
+
+TEST_F(UsbReportQueue, FullQueueReplacesNewest) {
+    for (uint8_t i = 1; i <= USB_REPORT_QUEUE_SIZE + 2; i++) {
+        push(i);
+    }
+    EXPECT_EQ(test_report_queue.count, USB_REPORT_QUEUE_SIZE);
+    for (int i = 1; i < USB_REPORT_QUEUE_SIZE; i++) {
+        EXPECT_EQ(start(), i);
+        usb_report_queue_transmitted(&test_report_queue);
+    }
+    EXPECT_EQ(start(), USB_REPORT_QUEUE_SIZE + 2);
+}
+
+TEST_F(UsbReportQueue, FullSharedQueueOnlyReplacesSameReportId) {
+    push_shared(REPORT_ID_KEYBOARD, 1);
+    EXPECT_EQ(start_shared(), shared_report(REPORT_ID_KEYBOARD, 1));
+    push_shared(REPORT_ID_CONSUMER, 1);
+    push_shared(REPORT_ID_NKRO, 1);
+    push_shared(REPORT_ID_SYSTEM, 1);
+    ASSERT_EQ(shared_report_queue.count, USB_REPORT_QUEUE_SIZE);
+
+    // The consumer release replaces the queued consumer press, not the queued system press
+    push_shared(REPORT_ID_CONSUMER, 0);
+    // Nothing of this kind is queued, so this one is dropped
+    push_shared(REPORT_ID_MOUSE, 1);
+    // Same ID, but another size
+    push_shared(REPORT_ID_NKRO, 2, 4);
+
+    usb_report_queue_transmitted(&shared_report_queue);
+
+    std::vector<shared_report> sent;
+    for (auto report = start_shared(); report.first != -1; report = start_shared()) {
+        usb_report_queue_transmitted(&shared_report_queue);
+        sent.push_back(report);
+    }
+    std::vector<shared_report> expected = {{REPORT_ID_CONSUMER, 0}, {REPORT_ID_NKRO, 1}, {REPORT_ID_SYSTEM, 1}};
+    EXPECT_EQ(sent, expected);
+}
+
+TEST_F(UsbReportQueue, InFlightReportIsNeverOverwritten) {
+    push(1);
+    EXPECT_EQ(start(), 1);
+    // Fill the rest of the queue, then overflow it
+    for (uint8_t i = 2; i <= USB_REPORT_QUEUE_SIZE + 3; i++) {
+        push(i);
+    }
+    EXPECT_EQ(usb_report_queue_slot(&test_report_queue, test_report_queue.head)[0], 1);
+    usb_report_queue_transmitted(&test_report_queue);
+    EXPECT_EQ(start(), 2);
+}
+
+TEST_F(UsbReportQueue, OversizedReportIsRefused) {
+    uint8_t report[9] = {1};
+    usb_report_queue_push(&test_report_queue, report, sizeof(report), NULL);
+    EXPECT_EQ(test_report_queue.count, 0);
+}
+
+TEST_F(UsbReportQueue, IdleReportDoesNotPop) {
+    push(1);
+    usb_report_queue_transmitted(&test_report_queue);
+    EXPECT_EQ(test_report_queue.count, 1);
+    EXPECT_EQ(start(), 1);
+}
+
+TEST_F(UsbReportQueue, ResetDropsEverything) {
+    push(1);
+    push(2);
+    EXPECT_EQ(start(), 1);
+    usb_report_queue_reset(&test_report_queue);
+    EXPECT_EQ(start(), -1);
+    push(3);
+    EXPECT_EQ(start(), 3);
+}
+
+TEST_F(UsbReportQueue, MouseMovementIsMerged) {
+    push_mouse(mouse(0, 10, -5));
+    push_mouse(mouse(0, 20, -6));
+    push_mouse(mouse(0, 3, 2));
+    ASSERT_EQ(mouse_report_queue.count, 1);
+    EXPECT_EQ(mouse_slot(0)->x, 33);
+    EXPECT_EQ(mouse_slot(0)->y, -9);
+}
+
+TEST_F(UsbReportQueue, MouseButtonChangeIsNotMerged) {
+    push_mouse(mouse(0, 10, 0));
+    push_mouse(mouse(1, 10, 0));
+    push_mouse(mouse(0, 10, 0));
+    ASSERT_EQ(mouse_report_queue.count, 3);
+    EXPECT_EQ(mouse_slot(0)->buttons, 0);
+    EXPECT_EQ(mouse_slot(1)->buttons, 1);
+    EXPECT_EQ(mouse_slot(2)->buttons, 0);
+}
+
+TEST_F(UsbReportQueue, MouseInFlightIsNotMerged) {
+    push_mouse(mouse(0, 10, 0));
+    start(&mouse_report_queue);
+    push_mouse(mouse(0, 5, 0));
+    ASSERT_EQ(mouse_report_queue.count, 2);
+    EXPECT_EQ(mouse_slot(0)->x, 10);
+    EXPECT_EQ(mouse_slot(1)->x, 5);
+}
+
+TEST_F(UsbReportQueue, MouseOverflowIsNotMerged) {
+#ifdef MOUSE_EXTENDED_REPORT
+    push_mouse(mouse(0, 30000, 0));
+    push_mouse(mouse(0, 30000, 0));
+#else
+    push_mouse(mouse(0, 100, 0));
+    push_mouse(mouse(0, 100, 0));
+#endif
+    EXPECT_EQ(mouse_report_queue.count, 2);
+}
+
+#ifdef MOUSE_EXTENDED_REPORT
+TEST_F(UsbReportQueue, MergedBootMovementMatchesHost) {
+    push_mouse(mouse(0, -100, 100));
+    push_mouse(mouse(0, -100, 100));
+    ASSERT_EQ(mouse_report_queue.count, 1);
+    EXPECT_EQ(mouse_slot(0)->x, -200);
+    EXPECT_EQ(mouse_slot(0)->y, 200);
+    EXPECT_EQ(mouse_slot(0)->boot_x, -127);
+    EXPECT_EQ(mouse_slot(0)->boot_y, 127);
+}
+#endif
@@ -0,0 +1,84 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "ws2812_spi_encode.h"
+}
+
+// The per-bit encoding the lookup table replaces
+static uint8_t protocol_eq(uint8_t data, int pos) {
+    uint8_t eq = (data & (1 << (2 * (3 - pos)))) ? 0b1110 : 0b1000;
+    eq += (data & (2 << (2 * (3 - pos)))) ? 0b11100000 : 0b10000000;
+    return eq;
+}
+
+static void expect_byte(const uint8_t *encoded, uint8_t data) {
+    for (int pos = 0; pos < WS2812_SPI_BYTES_PER_BYTE; pos++) {
+        EXPECT_EQ(encoded[pos], protocol_eq(data, pos)) << "byte " << (int)data << " pos " << pos;
+    }
+}
+
+TEST(WS2812SpiEncode, EveryByteMatchesBitEncoding) {
+    for (int data = 0; data < 256; data++) {
+        uint8_t encoded[WS2812_SPI_BYTES_PER_BYTE];
+        ws2812_spi_encode_byte(encoded, data);
+        expect_byte(encoded, data);
+    }
+}
+
+TEST(WS2812SpiEncode, BitTimings) {
+    uint8_t encoded[WS2812_SPI_BYTES_PER_BYTE];
+
+    // All zeros are short pulses, all ones long pulses
+    ws2812_spi_encode_byte(encoded, 0x00);
+    EXPECT_EQ(std::vector<uint8_t>(encoded, encoded + 4), std::vector<uint8_t>({0x88, 0x88, 0x88, 0x88}));
+    ws2812_spi_encode_byte(encoded, 0xFF);
+    EXPECT_EQ(std::vector<uint8_t>(encoded, encoded + 4), std::vector<uint8_t>({0xEE, 0xEE, 0xEE, 0xEE}));
+
+    // Most significant bit first
+    ws2812_spi_encode_byte(encoded, 0x80);
+    EXPECT_EQ(std::vector<uint8_t>(encoded, encoded + 4), std::vector<uint8_t>({0xE8, 0x88, 0x88, 0x88}));
+}
+
+TEST(WS2812SpiEncode, FrameInByteOrder) {
+    const uint16_t count = 5;
+    rgb_led_t      leds[count];
+    for (uint16_t i = 0; i < count; i++) {
+        leds[i].r = 0x10 + i;
+        leds[i].g = 0x20 + i;
+        leds[i].b = 0x30 + i;
+#ifdef RGBW
+        leds[i].w = 0x40 + i;
+#endif
+    }
+
+    const size_t         led_size = sizeof(rgb_led_t) * WS2812_SPI_BYTES_PER_BYTE;
+    std::vector<uint8_t> frame(count * led_size + 1, 0x5A);
+    ws2812_spi_encode(frame.data(), leds, count);
+
+    for (uint16_t i = 0; i < count; i++) {
+        const uint8_t *led = &frame[i * led_size];
+#if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
+        expect_byte(&led[0], leds[i].g);
+        expect_byte(&led[4], leds[i].r);
+        expect_byte(&led[8], leds[i].b);
+#elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_RGB)
+        expect_byte(&led[0], leds[i].r);
+        expect_byte(&led[4], leds[i].g);
+        expect_byte(&led[8], leds[i].b);
+#elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_BGR)
+        expect_byte(&led[0], leds[i].b);
+        expect_byte(&led[4], leds[i].g);
+        expect_byte(&led[8], leds[i].r);
+#endif
+#ifdef RGBW
+        expect_byte(&led[12], leds[i].w);
+#endif
+    }
+
+    // Nothing is written past the frame
+    EXPECT_EQ(frame.back(), 0x5A);
+}
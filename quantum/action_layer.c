@@ -1,5 +1,6 @@
 #include <limits.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "keyboard.h"
 #include "action.h"
@@ -316,6 +317,85 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
 #endif
 }
 
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_RESOLUTION_CACHE)
+#    ifndef LAYER_RESOLUTION_CACHE_SLOTS
+#        define LAYER_RESOLUTION_CACHE_SLOTS 2
+#    endif
+
+/* Resolved layer + 1 for every matrix position, 0 means not resolved yet. */
+typedef struct {
+    layer_state_t layers;
+    uint8_t       last_used;
+    uint8_t       layer[MATRIX_ROWS][MATRIX_COLS];
+} layer_resolution_cache_t;
+
+static layer_resolution_cache_t layer_resolution_cache[LAYER_RESOLUTION_CACHE_SLOTS] = {0};
+static uint8_t                  layer_resolution_cache_current                      = 0;
+static uint8_t                  layer_resolution_cache_tick                         = 0;
+
+/** \brief Clear layer resolution cache
+ *
+ * Forgets all resolved layers, must be called whenever the keymap changes
+ */
+void layer_resolution_cache_clear(void) {
+    for (uint8_t slot = 0; slot < LAYER_RESOLUTION_CACHE_SLOTS; slot++) {
+        memset(layer_resolution_cache[slot].layer, 0, sizeof(layer_resolution_cache[slot].layer));
+    }
+}
+
+/** \brief Invalidate layer resolution cache
+ *
+ * Forgets the resolved layer of a single key, for when only that key changed
+ */
+void layer_resolution_cache_invalidate(keypos_t key) {
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        for (uint8_t slot = 0; slot < LAYER_RESOLUTION_CACHE_SLOTS; slot++) {
+            layer_resolution_cache[slot].layer[key.row][key.col] = 0;
+        }
+    }
+}
+
+/** \brief Get layer resolution cache entry
+ *
+ * Returns the cache entry of key for the given layer state, replacing the
+ * least recently used snapshot when the layer state has not been seen yet.
+ * Keys outside of the matrix are not cached.
+ */
+static uint8_t *layer_resolution_cache_entry(layer_state_t layers, keypos_t key) {
+    if (key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) {
+        return NULL;
+    }
+
+    layer_resolution_cache_t *cache = &layer_resolution_cache[layer_resolution_cache_current];
+    if (cache->layers != layers) {
+        uint8_t victim = layer_resolution_cache_current;
+        uint8_t oldest = 0;
+        layer_resolution_cache_tick++;
+        for (uint8_t slot = 0; slot < LAYER_RESOLUTION_CACHE_SLOTS; slot++) {
+            if (layer_resolution_cache[slot].layers == layers) {
+                victim = slot;
+                break;
+            }
+            uint8_t age = layer_resolution_cache_tick - layer_resolution_cache[slot].last_used;
+            if (age > oldest) {
+                victim = slot;
+                oldest = age;
+            }
+        }
+
+        cache = &layer_resolution_cache[victim];
+        if (cache->layers != layers) {
+            cache->layers = layers;
+            memset(cache->layer, 0, sizeof(cache->layer));
+        }
+        cache->last_used               = layer_resolution_cache_tick;
+        layer_resolution_cache_current = victim;
+    }
+
+    return &cache->layer[key.row][key.col];
+}
+#endif
+
 /** \brief Layer switch get layer
  *
  * Gets the layer based on key info
@@ -326,17 +406,30 @@ uint8_t layer_switch_get_layer(keypos_t key) {
     action.code = ACTION_TRANSPARENT;
 
     layer_state_t layers = layer_state | default_layer_state;
+    uint8_t       layer  = 0;
+#    ifdef LAYER_RESOLUTION_CACHE
+    uint8_t *cached = layer_resolution_cache_entry(layers, key);
+    if (cached != NULL && *cached != 0) {
+        return *cached - 1;
+    }
+#    endif
     /* check top layer first */
     for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
         if (layers & ((layer_state_t)1 << i)) {
             action = action_for_key(i, key);
             if (action.code != ACTION_TRANSPARENT) {
-                return i;
+                layer = i;
+                break;
             }
         }
     }
-    /* fall back to layer 0 */
-    return 0;
+    /* otherwise fall back to layer 0 */
+#    ifdef LAYER_RESOLUTION_CACHE
+    if (cached != NULL) {
+        *cached = layer + 1;
+    }
+#    endif
+    return layer;
 #else
     return get_highest_layer(default_layer_state);
 #endif
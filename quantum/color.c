@@ -53,7 +53,9 @@ RGB hsv_to_rgb_impl(HSV hsv, bool use_cie) {
     v = hsv.v;
 #endif
 
-    region    = h * 6 / 255;
+    // h * 6 / 255, without the division that has to be done in software on
+    // AVR and Cortex-M0
+    region    = (h * 6 + 1 + ((h * 6) >> 8)) >> 8;
     remainder = (h * 2 - region * 85) * 3;
 
     p = (v * (255 - s)) >> 8;
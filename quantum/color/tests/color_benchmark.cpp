@@ -0,0 +1,48 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "benchmark.hpp"
+#include "color_reference.hpp"
+
+TEST(ColorBenchmark, HsvToRgbMatchesReferenceForAllValues) {
+    for (uint32_t i = 0; i < (1 << 24); i++) {
+        HSV hsv = {.h = (uint8_t)(i >> 16), .s = (uint8_t)(i >> 8), .v = (uint8_t)i};
+#ifdef USE_CIE1931_CURVE
+        ASSERT_TRUE(rgb_eq(hsv_to_rgb(hsv), reference_hsv_to_rgb(hsv, true))) << "hsv " << i;
+#else
+        ASSERT_TRUE(rgb_eq(hsv_to_rgb(hsv), reference_hsv_to_rgb(hsv, false))) << "hsv " << i;
+#endif
+        ASSERT_TRUE(rgb_eq(hsv_to_rgb_nocie(hsv), reference_hsv_to_rgb(hsv, false))) << "hsv " << i;
+    }
+}
+
+/**
+ * Host benchmark of the conversion of a 120 LED rainbow frame, the way the
+ * rgb_matrix effect runners call it, against the reference implementation.
+ *
+ * The division only costs a few cycles on the host, the gain is on AVR and
+ * Cortex-M0 where it is a library call. CPU times are only comparable between
+ * runs on the same machine.
+ */
+TEST(ColorBenchmark, HsvToRgbFrameTime) {
+    const int led_count = 120;
+    const int frames    = 20000;
+
+    auto run = [&](RGB (*convert)(HSV), uint32_t* checksum) {
+        return benchmark::ns_per_iteration(frames, [&](uint64_t frame) {
+            for (int i = 0; i < led_count; i++) {
+                HSV hsv = {.h = (uint8_t)(frame + i * 2), .s = 255, .v = (uint8_t)(255 - i)};
+                RGB rgb = convert(hsv);
+                *checksum += rgb.r + rgb.g + rgb.b;
+            }
+        });
+    };
+
+    uint32_t reference_checksum = 0, checksum = 0;
+    double   reference_ns = run([](HSV hsv) { return reference_hsv_to_rgb(hsv, false); }, &reference_checksum);
+    double   ns           = run(hsv_to_rgb_nocie, &checksum);
+    EXPECT_EQ(checksum, reference_checksum);
+
+    benchmark::Line() << "hsv_to_rgb     " << led_count << " leds | reference: " << benchmark::field(reference_ns, 8) << " ns/frame | current: " << benchmark::field(ns, 8) << " ns/frame";
+}
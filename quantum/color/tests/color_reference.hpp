@@ -0,0 +1,59 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+extern "C" {
+#include "color.h"
+#include "led_tables.h"
+}
+
+// The channels of RGB are laid out in WS2812_BYTE_ORDER
+static inline RGB make_rgb(uint8_t r, uint8_t g, uint8_t b) {
+    RGB rgb;
+    rgb.r = r;
+    rgb.g = g;
+    rgb.b = b;
+    return rgb;
+}
+
+// The conversion as it was written before the division was taken out
+static inline RGB reference_hsv_to_rgb(HSV hsv, bool use_cie) {
+    uint8_t v = hsv.v;
+#ifdef USE_CIE1931_CURVE
+    if (use_cie) {
+        v = CIE1931_CURVE[hsv.v];
+    }
+#endif
+    if (hsv.s == 0) {
+        return make_rgb(v, v, v);
+    }
+
+    uint16_t h         = hsv.h;
+    uint16_t s         = hsv.s;
+    uint8_t  region    = h * 6 / 255;
+    uint8_t  remainder = (h * 2 - region * 85) * 3;
+    uint8_t  p         = (v * (255 - s)) >> 8;
+    uint8_t  q         = (v * (255 - ((s * remainder) >> 8))) >> 8;
+    uint8_t  t         = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+
+    switch (region) {
+        case 6:
+        case 0:
+            return make_rgb(v, t, p);
+        case 1:
+            return make_rgb(q, v, p);
+        case 2:
+            return make_rgb(p, v, t);
+        case 3:
+            return make_rgb(p, q, v);
+        case 4:
+            return make_rgb(t, p, v);
+        default:
+            return make_rgb(v, p, q);
+    }
+}
+
+static inline bool rgb_eq(RGB a, RGB b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b;
+}
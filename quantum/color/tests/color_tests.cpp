@@ -0,0 +1,29 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "color_reference.hpp"
+
+// Every hue and saturation, for a spread of values. The color_benchmark tests check all 2^24 HSV values.
+TEST(Color, HsvToRgbMatchesReference) {
+    for (uint32_t i = 0; i < (1 << 16); i++) {
+        for (uint16_t v = 0; v <= 255; v += 15) {
+            HSV hsv = {.h = (uint8_t)(i >> 8), .s = (uint8_t)i, .v = (uint8_t)v};
+#ifdef USE_CIE1931_CURVE
+            ASSERT_TRUE(rgb_eq(hsv_to_rgb(hsv), reference_hsv_to_rgb(hsv, true))) << "hsv " << (i << 8 | v);
+#else
+            ASSERT_TRUE(rgb_eq(hsv_to_rgb(hsv), reference_hsv_to_rgb(hsv, false))) << "hsv " << (i << 8 | v);
+#endif
+            ASSERT_TRUE(rgb_eq(hsv_to_rgb_nocie(hsv), reference_hsv_to_rgb(hsv, false))) << "hsv " << (i << 8 | v);
+        }
+    }
+}
+
+TEST(Color, HsvToRgbPrimaries) {
+    HSV red   = {.h = 0, .s = 255, .v = 255};
+    HSV green = {.h = 85, .s = 255, .v = 255};
+    HSV blue  = {.h = 170, .s = 255, .v = 255};
+    EXPECT_TRUE(rgb_eq(hsv_to_rgb_nocie(red), make_rgb(255, 0, 0)));
+    EXPECT_TRUE(rgb_eq(hsv_to_rgb_nocie(green), make_rgb(0, 255, 0)));
+    EXPECT_TRUE(rgb_eq(hsv_to_rgb_nocie(blue), make_rgb(0, 0, 255)));
+}
@@ -0,0 +1,21 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+color_SRC := \
+	$(QUANTUM_PATH)/color/tests/color_tests.cpp \
+	$(QUANTUM_PATH)/color.c
+
+color_cie_DEFS := -DUSE_CIE1931_CURVE
+color_cie_SRC := $(color_SRC) \
+	$(QUANTUM_PATH)/led_tables.c
+
+color_benchmark_SRC := \
+	$(QUANTUM_PATH)/color/tests/color_benchmark.cpp \
+	$(QUANTUM_PATH)/color.c
+color_benchmark_INC := \
+	tests/test_common
+
+color_cie_benchmark_DEFS := -DUSE_CIE1931_CURVE
+color_cie_benchmark_SRC := $(color_benchmark_SRC) \
+	$(QUANTUM_PATH)/led_tables.c
+color_cie_benchmark_INC := $(color_benchmark_INC)
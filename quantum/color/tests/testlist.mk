@@ -0,0 +1,2 @@
+TEST_LIST += color color_cie
+BENCHMARK_LIST += color_benchmark color_cie_benchmark
@@ -0,0 +1,89 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+Bit-sliced debounce counters. The counters of a matrix row are stored as vertical bit
+planes: bit `col` of plane `p` is bit `p` of the counter of column `col`. A whole row of
+counters is loaded or aged with a few bitwise operations per plane, instead of one
+operation per key.
+
+Only included by the bit-sliced debounce algorithms, after DEBOUNCE has been clamped.
+*/
+
+#pragma once
+
+#include "matrix.h"
+
+// Number of planes needed to hold DEBOUNCE
+#if DEBOUNCE < 2
+#    define DEBOUNCE_PLANES 1
+#elif DEBOUNCE < 4
+#    define DEBOUNCE_PLANES 2
+#elif DEBOUNCE < 8
+#    define DEBOUNCE_PLANES 3
+#elif DEBOUNCE < 16
+#    define DEBOUNCE_PLANES 4
+#elif DEBOUNCE < 32
+#    define DEBOUNCE_PLANES 5
+#elif DEBOUNCE < 64
+#    define DEBOUNCE_PLANES 6
+#elif DEBOUNCE < 128
+#    define DEBOUNCE_PLANES 7
+#else
+#    define DEBOUNCE_PLANES 8
+#endif
+
+typedef matrix_row_t debounce_planes_t[DEBOUNCE_PLANES];
+
+/**
+ * @brief Sets the counters of the keys in mask to DEBOUNCE.
+ */
+static inline void debounce_planes_load(debounce_planes_t planes, matrix_row_t mask) {
+    for (uint8_t p = 0; p < DEBOUNCE_PLANES; p++) {
+        if ((DEBOUNCE >> p) & 1) {
+            planes[p] |= mask;
+        } else {
+            planes[p] &= ~mask;
+        }
+    }
+}
+
+/**
+ * @brief Clears the counters of the keys outside of mask.
+ */
+static inline void debounce_planes_keep(debounce_planes_t planes, matrix_row_t mask) {
+    for (uint8_t p = 0; p < DEBOUNCE_PLANES; p++) {
+        planes[p] &= mask;
+    }
+}
+
+/**
+ * @brief Subtracts elapsed_time from the counters of the keys in active.
+ *
+ * Counters that reach zero are cleared, like the counters of inactive keys.
+ *
+ * @return the keys whose counter expired
+ */
+static inline matrix_row_t debounce_planes_age(debounce_planes_t planes, matrix_row_t active, uint8_t elapsed_time) {
+    // Counters never exceed DEBOUNCE, which the planes can hold
+    if (elapsed_time >> DEBOUNCE_PLANES) {
+        debounce_planes_keep(planes, 0);
+        return active;
+    }
+
+    // Ripple borrow subtraction of the same value from every column at once
+    matrix_row_t borrow  = 0;
+    matrix_row_t nonzero = 0;
+    for (uint8_t p = 0; p < DEBOUNCE_PLANES; p++) {
+        matrix_row_t a = planes[p];
+        matrix_row_t b = ((elapsed_time >> p) & 1) ? (matrix_row_t)~(matrix_row_t)0 : 0;
+
+        planes[p] = a ^ b ^ borrow;
+        borrow    = (~a & (b | borrow)) | (b & borrow);
+        nonzero |= planes[p];
+    }
+
+    matrix_row_t expired = active & (borrow | ~nonzero);
+    debounce_planes_keep(planes, active & ~expired);
+    return expired;
+}
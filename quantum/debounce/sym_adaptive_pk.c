@@ -0,0 +1,277 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+Adaptive symmetric per-key algorithm. Like sym_defer_pk, a key change is pushed once
+the key has been stable for its debounce time, but every key has its own debounce
+time between DEBOUNCE_ADAPTIVE_MIN and DEBOUNCE_ADAPTIVE_MAX, starting at DEBOUNCE.
+
+After a run of clean transitions the time of a key shrinks by a millisecond, lowering
+its latency. If a bounce comes close to the debounce time, or the key chatters right
+after a change was pushed, its time grows again. All state is statically allocated.
+*/
+
+#include "debounce.h"
+#include "timer.h"
+#include "debounce/sym_adaptive_pk.h"
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 127ms
+#if DEBOUNCE > 127
+#    undef DEBOUNCE
+#    define DEBOUNCE 127
+#endif
+
+#ifndef DEBOUNCE_ADAPTIVE_MIN
+#    define DEBOUNCE_ADAPTIVE_MIN 2
+#endif
+
+#ifndef DEBOUNCE_ADAPTIVE_MAX
+#    define DEBOUNCE_ADAPTIVE_MAX (DEBOUNCE * 4 < 127 ? DEBOUNCE * 4 : 127)
+#endif
+
+// A bounce this close to the debounce time counts as a near miss
+#ifndef DEBOUNCE_ADAPTIVE_MARGIN
+#    define DEBOUNCE_ADAPTIVE_MARGIN 1
+#endif
+
+// Number of consecutive clean transitions before the debounce time shrinks
+#ifndef DEBOUNCE_ADAPTIVE_SHRINK_AFTER
+#    define DEBOUNCE_ADAPTIVE_SHRINK_AFTER 16
+#endif
+
+#define ROW_SHIFTER ((matrix_row_t)1)
+
+#if DEBOUNCE > 0
+
+_Static_assert(DEBOUNCE_ADAPTIVE_MIN > 0 && DEBOUNCE_ADAPTIVE_MIN <= DEBOUNCE && DEBOUNCE <= DEBOUNCE_ADAPTIVE_MAX && DEBOUNCE_ADAPTIVE_MAX <= 127, "Adaptive debounce requires 0 < DEBOUNCE_ADAPTIVE_MIN <= DEBOUNCE <= DEBOUNCE_ADAPTIVE_MAX <= 127");
+_Static_assert(DEBOUNCE_ADAPTIVE_SHRINK_AFTER < 64, "DEBOUNCE_ADAPTIVE_SHRINK_AFTER must be below 64");
+
+enum { IDLE, SETTLING, COOLDOWN };
+
+typedef struct {
+    uint8_t remaining;  // milliseconds left in the current phase
+    uint8_t age;        // milliseconds since the first edge of the transition
+    uint8_t last_edge;  // age of the latest edge
+    uint8_t max_gap;    // longest stable time between edges of the transition
+    uint8_t window;     // debounce time of this key
+    uint8_t phase : 2;  // IDLE, SETTLING or COOLDOWN, which catches chatter for a window after a change was pushed
+    uint8_t clean : 6;  // consecutive clean transitions
+} debounce_key_t;
+
+static debounce_key_t debounce_keys[MATRIX_ROWS * MATRIX_COLS];
+static uint8_t        debounce_histogram[MATRIX_ROWS * MATRIX_COLS][DEBOUNCE_ADAPTIVE_BUCKETS];
+static matrix_row_t   last_raw[MATRIX_ROWS];
+static uint8_t        debounce_rows;
+static fast_timer_t   last_time;
+static bool           counters_need_update;
+static bool           cooked_changed;
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time);
+static void start_debounce_counters(matrix_row_t raw[], uint8_t num_rows);
+
+static void record(uint16_t index, uint8_t bucket) {
+    uint8_t *histogram = debounce_histogram[index];
+    if (histogram[bucket] == UINT8_MAX) {
+        // Halve everything, which keeps the proportions
+        for (uint8_t i = 0; i < DEBOUNCE_ADAPTIVE_BUCKETS; i++) {
+            histogram[i] >>= 1;
+        }
+    }
+    histogram[bucket]++;
+}
+
+static void grow(debounce_key_t *key, uint8_t window) {
+    key->window = window < DEBOUNCE_ADAPTIVE_MAX ? window : DEBOUNCE_ADAPTIVE_MAX;
+    key->clean  = 0;
+}
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+    debounce_rows = num_rows < MATRIX_ROWS ? num_rows : MATRIX_ROWS;
+    for (uint16_t i = 0; i < MATRIX_ROWS * MATRIX_COLS; i++) {
+        debounce_keys[i] = (debounce_key_t){.window = DEBOUNCE, .phase = IDLE};
+        for (uint8_t b = 0; b < DEBOUNCE_ADAPTIVE_BUCKETS; b++) {
+            debounce_histogram[i][b] = 0;
+        }
+    }
+    for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
+        last_raw[r] = 0;
+    }
+    counters_need_update = false;
+}
+
+void debounce_free(void) {}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    bool updated_last = false;
+    cooked_changed    = false;
+
+    if (num_rows > debounce_rows) {
+        num_rows = debounce_rows;
+    }
+
+    if (counters_need_update) {
+        fast_timer_t now          = timer_read_fast();
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+
+        last_time    = now;
+        updated_last = true;
+        if (elapsed_time > UINT8_MAX) {
+            elapsed_time = UINT8_MAX;
+        }
+
+        if (elapsed_time > 0) {
+            update_debounce_counters_and_transfer_if_expired(raw, cooked, num_rows, elapsed_time);
+        }
+    }
+
+    if (changed) {
+        if (!updated_last) {
+            last_time = timer_read_fast();
+        }
+
+        start_debounce_counters(raw, num_rows);
+    }
+
+    return cooked_changed;
+}
+
+static void finish_transition(debounce_key_t *key, uint16_t index) {
+    uint8_t settle = key->last_edge;
+    record(index, settle == 0 ? DEBOUNCE_ADAPTIVE_CLEAN : settle <= 2 ? DEBOUNCE_ADAPTIVE_BOUNCE_2 : settle <= 5 ? DEBOUNCE_ADAPTIVE_BOUNCE_5 : DEBOUNCE_ADAPTIVE_BOUNCE_X);
+
+    if (key->max_gap + DEBOUNCE_ADAPTIVE_MARGIN >= key->window) {
+        // A bounce nearly got through
+        grow(key, key->window + 1);
+    } else if (key->max_gap + DEBOUNCE_ADAPTIVE_MARGIN < key->window - 1 && key->window > DEBOUNCE_ADAPTIVE_MIN) {
+        if (++key->clean >= DEBOUNCE_ADAPTIVE_SHRINK_AFTER) {
+            key->window--;
+            key->clean = 0;
+        }
+    }
+}
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time) {
+    debounce_key_t *key   = debounce_keys;
+    uint16_t        index = 0;
+
+    counters_need_update = false;
+    for (uint8_t row = 0; row < num_rows; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++, key++, index++) {
+            if (key->phase == IDLE) {
+                continue;
+            }
+
+            if (key->phase == SETTLING) {
+                key->age = key->age + elapsed_time < UINT8_MAX ? key->age + elapsed_time : UINT8_MAX;
+            }
+
+            if (key->remaining > elapsed_time) {
+                key->remaining -= elapsed_time;
+                counters_need_update = true;
+                continue;
+            }
+
+            if (key->phase == SETTLING) {
+                matrix_row_t col_mask    = (ROW_SHIFTER << col);
+                matrix_row_t cooked_next = (cooked[row] & ~col_mask) | (raw[row] & col_mask);
+
+                finish_transition(key, index);
+                if (cooked_next != cooked[row]) {
+                    cooked[row]    = cooked_next;
+                    cooked_changed = true;
+
+                    // Keep watching for chatter for another window
+                    key->phase           = COOLDOWN;
+                    key->remaining       = key->window;
+                    counters_need_update = true;
+                    continue;
+                }
+            }
+
+            key->phase     = IDLE;
+            key->remaining = 0;
+        }
+    }
+}
+
+static void start_debounce_counters(matrix_row_t raw[], uint8_t num_rows) {
+    debounce_key_t *key   = debounce_keys;
+    uint16_t        index = 0;
+
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t edges = raw[row] ^ last_raw[row];
+        last_raw[row]      = raw[row];
+
+        for (uint8_t col = 0; col < MATRIX_COLS; col++, key++, index++) {
+            if (!(edges & (ROW_SHIFTER << col))) {
+                continue;
+            }
+
+            if (key->phase == SETTLING) {
+                // Bounce, restart the debounce time from this edge
+                uint8_t gap = key->age - key->last_edge;
+                if (gap > key->max_gap) {
+                    key->max_gap = gap;
+                }
+                key->last_edge = key->age;
+            } else {
+                if (key->phase == COOLDOWN) {
+                    // The previous change was pushed too early
+                    record(index, DEBOUNCE_ADAPTIVE_CHATTER);
+                    grow(key, key->window * 2);
+                }
+                key->phase     = SETTLING;
+                key->age       = 0;
+                key->last_edge = 0;
+                key->max_gap   = 0;
+            }
+
+            key->remaining       = key->window;
+            counters_need_update = true;
+        }
+    }
+}
+
+bool debounce_adaptive_get_stats(uint8_t row, uint8_t col, debounce_adaptive_stats_t *stats) {
+    if (row >= MATRIX_ROWS || col >= MATRIX_COLS) {
+        return false;
+    }
+
+    uint16_t index = row * MATRIX_COLS + col;
+    stats->window = debounce_keys[index].window;
+    for (uint8_t b = 0; b < DEBOUNCE_ADAPTIVE_BUCKETS; b++) {
+        stats->histogram[b] = debounce_histogram[index][b];
+    }
+    return true;
+}
+
+#else
+#    include "none.c"
+
+bool debounce_adaptive_get_stats(uint8_t row, uint8_t col, debounce_adaptive_stats_t *stats) {
+    return false;
+}
+#endif
+
+bool debounce_adaptive_raw_hid_receive(uint8_t *data, uint8_t length) {
+    if (length < 4 + DEBOUNCE_ADAPTIVE_BUCKETS || data[0] != DEBOUNCE_ADAPTIVE_RAW_HID_ID) {
+        return false;
+    }
+
+    debounce_adaptive_stats_t stats;
+    if (!debounce_adaptive_get_stats(data[1], data[2], &stats)) {
+        data[3] = 0xFF;
+        return true;
+    }
+
+    data[3] = stats.window;
+    for (uint8_t b = 0; b < DEBOUNCE_ADAPTIVE_BUCKETS; b++) {
+        data[4 + b] = stats.histogram[b];
+    }
+    return true;
+}
@@ -0,0 +1,50 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Buckets of the per-key bounce histogram, by the time a transition took to settle.
+ */
+enum debounce_adaptive_bucket {
+    DEBOUNCE_ADAPTIVE_CLEAN,    // a single edge
+    DEBOUNCE_ADAPTIVE_BOUNCE_2, // settled within 2ms
+    DEBOUNCE_ADAPTIVE_BOUNCE_5, // settled within 5ms
+    DEBOUNCE_ADAPTIVE_BOUNCE_X, // took longer than 5ms to settle
+    DEBOUNCE_ADAPTIVE_CHATTER,  // changed again right after a debounced change
+    DEBOUNCE_ADAPTIVE_BUCKETS,
+};
+
+typedef struct {
+    uint8_t window; // current debounce time in milliseconds
+    uint8_t histogram[DEBOUNCE_ADAPTIVE_BUCKETS];
+} debounce_adaptive_stats_t;
+
+/**
+ * @brief Retrieves the debounce time and bounce statistics of a key.
+ *
+ * @return false if the key is outside of the matrix.
+ */
+bool debounce_adaptive_get_stats(uint8_t row, uint8_t col, debounce_adaptive_stats_t *stats);
+
+/**
+ * @def DEBOUNCE_ADAPTIVE_RAW_HID_ID
+ * @brief First byte of the raw HID requests handled by debounce_adaptive_raw_hid_receive().
+ */
+#ifndef DEBOUNCE_ADAPTIVE_RAW_HID_ID
+#    define DEBOUNCE_ADAPTIVE_RAW_HID_ID 0xDB
+#endif
+
+/**
+ * @brief Answers a request for the statistics of a key, for use from raw_hid_receive_kb() or via_command_kb().
+ *
+ * The request is `[DEBOUNCE_ADAPTIVE_RAW_HID_ID][row][col]`. The response is written over it as
+ * `[DEBOUNCE_ADAPTIVE_RAW_HID_ID][row][col][window][histogram...]`, or with 0xFF as window if the
+ * key does not exist. The caller sends the response.
+ *
+ * @return true if the packet was a statistics request and has been answered.
+ */
+bool debounce_adaptive_raw_hid_receive(uint8_t *data, uint8_t length);
@@ -0,0 +1,122 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+Bit-sliced version of sym_defer_pk, with identical output. The per-key counters are
+held as bit planes over matrix rows (see bitslice.h), so a scan costs a few bitwise
+operations per row rather than a counter update per key, and rows without a running
+counter are skipped. All state is statically allocated.
+*/
+
+#include "debounce.h"
+#include "timer.h"
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 255ms
+#if DEBOUNCE > UINT8_MAX
+#    undef DEBOUNCE
+#    define DEBOUNCE UINT8_MAX
+#endif
+
+#if DEBOUNCE > 0
+#    include "debounce/bitslice.h"
+
+static debounce_planes_t debounce_counters[MATRIX_ROWS];
+static matrix_row_t      counting[MATRIX_ROWS];
+static fast_timer_t      last_time;
+static bool              counters_need_update;
+static bool              cooked_changed;
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time);
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows);
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+    for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
+        debounce_planes_keep(debounce_counters[r], 0);
+        counting[r] = 0;
+    }
+    counters_need_update = false;
+}
+
+void debounce_free(void) {}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    bool updated_last = false;
+    cooked_changed    = false;
+
+    if (num_rows > MATRIX_ROWS) {
+        num_rows = MATRIX_ROWS;
+    }
+
+    if (counters_need_update) {
+        fast_timer_t now          = timer_read_fast();
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+
+        last_time    = now;
+        updated_last = true;
+        if (elapsed_time > UINT8_MAX) {
+            elapsed_time = UINT8_MAX;
+        }
+
+        if (elapsed_time > 0) {
+            update_debounce_counters_and_transfer_if_expired(raw, cooked, num_rows, elapsed_time);
+        }
+    }
+
+    if (changed) {
+        if (!updated_last) {
+            last_time = timer_read_fast();
+        }
+
+        start_debounce_counters(raw, cooked, num_rows);
+    }
+
+    return cooked_changed;
+}
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time) {
+    counters_need_update = false;
+    for (uint8_t row = 0; row < num_rows; row++) {
+        if (!counting[row]) {
+            continue;
+        }
+
+        matrix_row_t expired = debounce_planes_age(debounce_counters[row], counting[row], elapsed_time);
+        counting[row] &= ~expired;
+        if (expired) {
+            matrix_row_t cooked_next = (cooked[row] & ~expired) | (raw[row] & expired);
+            cooked_changed |= cooked[row] ^ cooked_next;
+            cooked[row] = cooked_next;
+        }
+        if (counting[row]) {
+            counters_need_update = true;
+        }
+    }
+}
+
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t delta = raw[row] ^ cooked[row];
+
+        // Keys back at their debounced state stop counting
+        if (counting[row] & ~delta) {
+            debounce_planes_keep(debounce_counters[row], delta);
+            counting[row] &= delta;
+        }
+
+        matrix_row_t start = delta & ~counting[row];
+        if (start) {
+            debounce_planes_load(debounce_counters[row], start);
+            counting[row] |= start;
+            counters_need_update = true;
+        }
+    }
+}
+
+#else
+#    include "none.c"
+#endif
@@ -0,0 +1,112 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <string>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include <stdlib.h>
+#include "debounce.h"
+#include "timer.h"
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+/* The algorithm the bit-sliced one under test replaces, built into its own
+ * namespace so both can run side by side on the same input. */
+namespace reference {
+#include DEBOUNCE_REFERENCE
+}
+
+class DebounceBitslice : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(7777);
+        debounce_init(MATRIX_ROWS);
+        reference::debounce_init(MATRIX_ROWS);
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            raw[row] = expected[row] = cooked[row] = 0;
+        }
+    }
+
+    void TearDown() override {
+        debounce_free();
+        reference::debounce_free();
+    }
+
+    void toggle(std::mt19937 &rng, int keys) {
+        for (int i = 0; i < keys; i++) {
+            raw[rng() % MATRIX_ROWS] ^= (matrix_row_t)1 << (rng() % MATRIX_COLS);
+        }
+    }
+
+    void scan(bool changed) {
+        bool expected_changed = reference::debounce(raw, expected, MATRIX_ROWS, changed);
+        bool cooked_changed   = debounce(raw, cooked, MATRIX_ROWS, changed);
+
+        ASSERT_EQ(cooked_changed, expected_changed) << "at " << timer_read_fast();
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            ASSERT_EQ(cooked[row], expected[row]) << "row " << (int)row << " at " << timer_read_fast();
+        }
+    }
+
+    /* Scans at 0 to max_step ms intervals, every scan toggling up to max_keys
+     * random keys with the given probability in percent. */
+    void run(uint32_t seed, int scans, uint32_t max_step, int probability, int max_keys) {
+        std::mt19937 rng(seed);
+        for (int i = 0; i < scans; i++) {
+            advance_time(rng() % (max_step + 1));
+            bool changed = (int)(rng() % 100) < probability;
+            if (changed) {
+                toggle(rng, 1 + rng() % max_keys);
+            }
+            scan(changed);
+            if (HasFatalFailure()) {
+                FAIL() << "seed " << seed << " scan " << i;
+            }
+        }
+    }
+
+    matrix_row_t raw[MATRIX_ROWS];
+    matrix_row_t expected[MATRIX_ROWS];
+    matrix_row_t cooked[MATRIX_ROWS];
+};
+
+TEST_F(DebounceBitslice, FastScanRate) {
+    for (uint32_t seed = 1; seed <= 10; seed++) {
+        run(seed, 20000, 1, 10, 2);
+    }
+}
+
+TEST_F(DebounceBitslice, SlowScanRate) {
+    for (uint32_t seed = 1; seed <= 10; seed++) {
+        run(seed, 20000, DEBOUNCE * 2, 30, 3);
+    }
+}
+
+TEST_F(DebounceBitslice, ChatteringMatrix) {
+    // Many keys bouncing at the same time, in bursts
+    std::mt19937 rng(42);
+    for (int burst = 0; burst < 500; burst++) {
+        run(rng(), 50, 1, 90, MATRIX_ROWS * MATRIX_COLS / 2);
+        run(rng(), 50, 3, 0, 1);
+    }
+}
+
+TEST_F(DebounceBitslice, TimeJumps) {
+    for (uint32_t seed = 1; seed <= 10; seed++) {
+        run(seed, 100, 1, 50, 2);
+        // Longer than any counter and than the elapsed time clamp
+        advance_time(1 + seed * 100);
+        scan(false);
+        ASSERT_FALSE(HasFatalFailure());
+    }
+}
+
+TEST_F(DebounceBitslice, TimerWrap) {
+    set_time(UINT32_MAX - 1000);
+    for (uint32_t seed = 1; seed <= 10; seed++) {
+        run(seed, 500, 2, 30, 2);
+    }
+}
@@ -0,0 +1,107 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "benchmark.hpp"
+
+extern "C" {
+#include <stdlib.h>
+#include "debounce.h"
+#include "timer.h"
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+namespace reference {
+#include DEBOUNCE_REFERENCE
+}
+
+/**
+ * Host benchmark of a bit-sliced debounce algorithm against the per-key algorithm it replaces.
+ *
+ * Both replay the same recorded scans, one 1ms matrix scan after another, and their outputs are checked to be
+ * identical. CPU times are host wall clock times and only comparable between runs on the same machine.
+ */
+class DebounceBenchmark : public ::testing::Test {
+   protected:
+    struct Scan {
+        uint8_t      row;
+        matrix_row_t toggle; // keys that change in this scan
+    };
+
+    typedef bool (*debounce_fn)(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+
+    /* Replays the scans and returns the host time per scan, and the sum of the
+     * cooked matrix over all scans as a checksum. */
+    static double replay(const std::vector<Scan>& scans, void (*init)(uint8_t), void (*deinit)(void), debounce_fn fn, uint64_t* checksum) {
+        matrix_row_t raw[MATRIX_ROWS]    = {0};
+        matrix_row_t cooked[MATRIX_ROWS] = {0};
+
+        set_time(7777);
+        init(MATRIX_ROWS);
+        *checksum = 0;
+
+        double ns = benchmark::ns_per_iteration(scans.size(), [&](uint64_t i) {
+            const Scan& scan = scans[i];
+            advance_time(1);
+            raw[scan.row] ^= scan.toggle;
+            if (fn(raw, cooked, MATRIX_ROWS, scan.toggle != 0)) {
+                for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                    *checksum = *checksum * 31 + cooked[row];
+                }
+            }
+        });
+
+        deinit();
+        return ns;
+    }
+
+    static void run(const char* workload, const std::vector<Scan>& scans) {
+        uint64_t expected, actual;
+        double   reference_ns = replay(scans, reference::debounce_init, reference::debounce_free, reference::debounce, &expected);
+        double   bitslice_ns  = replay(scans, debounce_init, debounce_free, debounce, &actual);
+
+        EXPECT_EQ(actual, expected) << "bit-sliced output differs from " DEBOUNCE_BENCHMARK_NAME;
+
+        using benchmark::field;
+        benchmark::Line() << benchmark::label(DEBOUNCE_BENCHMARK_NAME, 14) << benchmark::label(workload, 8) << " scans: " << field(scans.size(), 7) << " | per-key: " << field(reference_ns, 7) << " ns/scan | bit-sliced: " << field(bitslice_ns, 7) << " ns/scan | speedup: " << field(reference_ns / bitslice_ns, 5) << "x";
+    }
+
+    static matrix_row_t key(std::mt19937& rng, uint8_t* row) {
+        *row = rng() % MATRIX_ROWS;
+        return (matrix_row_t)1 << (rng() % MATRIX_COLS);
+    }
+};
+
+TEST_F(DebounceBenchmark, Idle) {
+    run("idle", std::vector<Scan>(DEBOUNCE_BENCHMARK_SCANS, Scan{0, 0}));
+}
+
+TEST_F(DebounceBenchmark, Typing) {
+    // A key press or release every 40ms, bouncing for up to 3ms
+    std::mt19937      rng(1);
+    std::vector<Scan> scans(DEBOUNCE_BENCHMARK_SCANS, Scan{0, 0});
+    for (size_t i = 0; i + 40 <= scans.size(); i += 40) {
+        uint8_t      row;
+        matrix_row_t mask    = key(rng, &row);
+        int          bounces = rng() % 3;
+        for (int b = 0; b <= bounces * 2; b++) {
+            scans[i + b] = {row, mask};
+        }
+    }
+    run("typing", scans);
+}
+
+TEST_F(DebounceBenchmark, Chatter) {
+    // Noise on a random key in every other scan
+    std::mt19937      rng(2);
+    std::vector<Scan> scans(DEBOUNCE_BENCHMARK_SCANS, Scan{0, 0});
+    for (size_t i = 0; i < scans.size(); i += 2) {
+        uint8_t row;
+        scans[i].toggle = key(rng, &row);
+        scans[i].row    = row;
+    }
+    run("chatter", scans);
+}
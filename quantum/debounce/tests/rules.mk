@@ -43,6 +43,18 @@ debounce_sym_eager_pk_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/sym_eager_pk.c \
 	$(QUANTUM_PATH)/debounce/tests/sym_eager_pk_tests.cpp
 
+debounce_sym_defer_pk_bitslice_DEFS := $(DEBOUNCE_COMMON_DEFS) -DDEBOUNCE_REFERENCE=\"debounce/sym_defer_pk.c\"
+debounce_sym_defer_pk_bitslice_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_pk_bitslice.c \
+	$(QUANTUM_PATH)/debounce/tests/sym_defer_pk_tests.cpp \
+	$(QUANTUM_PATH)/debounce/tests/bitslice_tests.cpp
+
+debounce_sym_eager_pk_bitslice_DEFS := $(DEBOUNCE_COMMON_DEFS) -DDEBOUNCE_REFERENCE=\"debounce/sym_eager_pk.c\"
+debounce_sym_eager_pk_bitslice_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_eager_pk_bitslice.c \
+	$(QUANTUM_PATH)/debounce/tests/sym_eager_pk_tests.cpp \
+	$(QUANTUM_PATH)/debounce/tests/bitslice_tests.cpp
+
 debounce_sym_eager_pr_DEFS := $(DEBOUNCE_COMMON_DEFS)
 debounce_sym_eager_pr_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/sym_eager_pr.c \
@@ -52,3 +64,27 @@ debounce_asym_eager_defer_pk_DEFS := $(DEBOUNCE_COMMON_DEFS)
 debounce_asym_eager_defer_pk_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/asym_eager_defer_pk.c \
 	$(QUANTUM_PATH)/debounce/tests/asym_eager_defer_pk_tests.cpp
+
+debounce_sym_adaptive_pk_DEFS := $(DEBOUNCE_COMMON_DEFS) -DDEBOUNCE_ADAPTIVE_SHRINK_AFTER=4
+debounce_sym_adaptive_pk_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_adaptive_pk.c \
+	$(QUANTUM_PATH)/debounce/tests/sym_adaptive_pk_tests.cpp
+
+DEBOUNCE_BENCHMARK_DEFS := -DMATRIX_ROWS=24 -DMATRIX_COLS=24 -DDEBOUNCE=5 -DDEBOUNCE_BENCHMARK_SCANS=200000
+DEBOUNCE_BENCHMARK_INC := tests/test_common
+
+debounce_benchmark_sym_defer_pk_DEFS := $(DEBOUNCE_BENCHMARK_DEFS) \
+	-DDEBOUNCE_BENCHMARK_NAME=\"sym_defer_pk\" \
+	-DDEBOUNCE_REFERENCE=\"debounce/sym_defer_pk.c\"
+debounce_benchmark_sym_defer_pk_SRC := $(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/debounce/sym_defer_pk_bitslice.c \
+	$(QUANTUM_PATH)/debounce/tests/debounce_benchmark.cpp
+debounce_benchmark_sym_defer_pk_INC := $(DEBOUNCE_BENCHMARK_INC)
+
+debounce_benchmark_sym_eager_pk_DEFS := $(DEBOUNCE_BENCHMARK_DEFS) \
+	-DDEBOUNCE_BENCHMARK_NAME=\"sym_eager_pk\" \
+	-DDEBOUNCE_REFERENCE=\"debounce/sym_eager_pk.c\"
+debounce_benchmark_sym_eager_pk_SRC := $(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/debounce/sym_eager_pk_bitslice.c \
+	$(QUANTUM_PATH)/debounce/tests/debounce_benchmark.cpp
+debounce_benchmark_sym_eager_pk_INC := $(DEBOUNCE_BENCHMARK_INC)
@@ -0,0 +1,128 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include "debounce_test_common.h"
+
+extern "C" {
+#include "debounce/sym_adaptive_pk.h"
+}
+
+TEST_F(DebounceTest, OneKeyClean) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{0, 1, DOWN}}, {}},
+        {5, {}, {{0, 1, DOWN}}},
+        {20, {{0, 1, UP}}, {}},
+        {25, {}, {{0, 1, UP}}},
+    });
+    runEvents();
+}
+
+TEST_F(DebounceTest, BounceRestartsWindow) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{0, 1, DOWN}}, {}},
+        {1, {{0, 1, UP}}, {}},
+        {2, {{0, 1, DOWN}}, {}},
+        /* 5ms after the last edge */
+        {7, {}, {{0, 1, DOWN}}},
+    });
+    runEvents();
+}
+
+TEST_F(DebounceTest, GlitchIgnored) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{0, 1, DOWN}}, {}},
+        {1, {{0, 1, UP}}, {}},
+        {6, {}, {}},
+    });
+    runEvents();
+}
+
+TEST_F(DebounceTest, WindowShrinksOnCleanKey) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{0, 1, DOWN}}, {}},
+        {5, {}, {{0, 1, DOWN}}},
+        {20, {{0, 1, UP}}, {}},
+        {25, {}, {{0, 1, UP}}},
+        {40, {{0, 1, DOWN}}, {}},
+        {45, {}, {{0, 1, DOWN}}},
+        {60, {{0, 1, UP}}, {}},
+        /* Fourth clean transition, the window shrinks to 4ms */
+        {65, {}, {{0, 1, UP}}},
+        {80, {{0, 1, DOWN}}, {}},
+        {84, {}, {{0, 1, DOWN}}},
+        /* Other keys keep their window */
+        {100, {{0, 2, DOWN}}, {}},
+        {105, {}, {{0, 2, DOWN}}},
+    });
+    runEvents();
+
+    debounce_adaptive_stats_t stats;
+    ASSERT_TRUE(debounce_adaptive_get_stats(0, 1, &stats));
+    EXPECT_EQ(stats.window, 4);
+    EXPECT_EQ(stats.histogram[DEBOUNCE_ADAPTIVE_CLEAN], 5);
+}
+
+TEST_F(DebounceTest, NearMissGrowsWindow) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{0, 1, DOWN}}, {}},
+        {4, {{0, 1, UP}}, {}},
+        {8, {{0, 1, DOWN}}, {}},
+        /* The bounces were 4ms apart, 1ms from getting through */
+        {13, {}, {{0, 1, DOWN}}},
+        {30, {{0, 1, UP}}, {}},
+        {36, {}, {{0, 1, UP}}},
+    });
+    runEvents();
+
+    debounce_adaptive_stats_t stats;
+    ASSERT_TRUE(debounce_adaptive_get_stats(0, 1, &stats));
+    EXPECT_EQ(stats.histogram[DEBOUNCE_ADAPTIVE_BOUNCE_X], 1);
+    EXPECT_EQ(stats.histogram[DEBOUNCE_ADAPTIVE_CLEAN], 1);
+}
+
+TEST_F(DebounceTest, ChatterGrowsWindow) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{0, 1, DOWN}}, {}},
+        {5, {}, {{0, 1, DOWN}}},
+        /* Changes again right after the press was pushed, the window doubles */
+        {7, {{0, 1, UP}}, {}},
+        {17, {}, {{0, 1, UP}}},
+        {40, {{0, 1, DOWN}}, {}},
+        {50, {}, {{0, 1, DOWN}}},
+    });
+    runEvents();
+
+    debounce_adaptive_stats_t stats;
+    ASSERT_TRUE(debounce_adaptive_get_stats(0, 1, &stats));
+    EXPECT_EQ(stats.window, 10);
+    EXPECT_EQ(stats.histogram[DEBOUNCE_ADAPTIVE_CHATTER], 1);
+}
+
+TEST_F(DebounceTest, StatsOverRawHid) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{1, 3, DOWN}}, {}},
+        {5, {}, {{1, 3, DOWN}}},
+    });
+    runEvents();
+
+    uint8_t data[32] = {DEBOUNCE_ADAPTIVE_RAW_HID_ID, 1, 3};
+    ASSERT_TRUE(debounce_adaptive_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(data[3], 5);
+    EXPECT_EQ(data[4 + DEBOUNCE_ADAPTIVE_CLEAN], 1);
+
+    uint8_t missing[32] = {DEBOUNCE_ADAPTIVE_RAW_HID_ID, MATRIX_ROWS, 0};
+    ASSERT_TRUE(debounce_adaptive_raw_hid_receive(missing, sizeof(missing)));
+    EXPECT_EQ(missing[3], 0xFF);
+
+    uint8_t other[32] = {0x01, 1, 3};
+    EXPECT_FALSE(debounce_adaptive_raw_hid_receive(other, sizeof(other)));
+}
@@ -3,6 +3,13 @@ TEST_LIST += \
 	debounce_sym_defer_g \
 	debounce_sym_defer_pk \
 	debounce_sym_defer_pr \
+	debounce_sym_defer_pk_bitslice \
 	debounce_sym_eager_pk \
 	debounce_sym_eager_pr \
-	debounce_asym_eager_defer_pk
+	debounce_sym_eager_pk_bitslice \
+	debounce_asym_eager_defer_pk \
+	debounce_sym_adaptive_pk
+
+BENCHMARK_LIST += \
+	debounce_benchmark_sym_defer_pk \
+	debounce_benchmark_sym_eager_pk
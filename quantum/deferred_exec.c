@@ -13,30 +13,37 @@
 // Helpers
 //
 
-static deferred_token current_token = 0;
+_Static_assert(MAX_DEFERRED_EXECUTORS <= DEFERRED_EXEC_MAX_TABLE_SIZE, "MAX_DEFERRED_EXECUTORS is too large");
 
-static inline bool token_can_be_used(deferred_executor_t *table, size_t table_count, deferred_token token) {
-    if (token == INVALID_DEFERRED_TOKEN) {
-        return false;
-    }
-    for (int i = 0; i < table_count; ++i) {
-        if (table[i].token == token) {
-            return false;
-        }
-    }
-    return true;
+// The low bits of a token locate its table slot, so lookups never need to search the table
+#define TOKEN_SLOT_BITS 8
+#define TOKEN_SLOT_MASK ((1 << TOKEN_SLOT_BITS) - 1)
+
+static inline bool entry_is_active(deferred_executor_t *entry) {
+    return entry->callback != NULL;
 }
 
-static inline deferred_token allocate_token(deferred_executor_t *table, size_t table_count) {
-    deferred_token first = ++current_token;
-    while (!token_can_be_used(table, table_count, current_token)) {
-        ++current_token;
-        if (current_token == first) {
-            // If we've looped back around to the first, everything is already allocated (yikes!). Need to exit with a failure.
-            return INVALID_DEFERRED_TOKEN;
-        }
+static inline deferred_executor_t *find_entry(deferred_executor_t *table, size_t table_count, deferred_token token) {
+    // A slot of zero wraps around to an out-of-range index, which also rejects INVALID_DEFERRED_TOKEN
+    size_t slot = (size_t)(token & TOKEN_SLOT_MASK) - 1;
+    if (slot >= table_count) {
+        return NULL;
     }
-    return current_token;
+
+    // Stale tokens from earlier uses of the slot carry an older generation
+    deferred_executor_t *entry = &table[slot];
+    return (entry_is_active(entry) && entry->token == token) ? entry : NULL;
+}
+
+static inline deferred_token allocate_token(deferred_executor_t *entry, size_t slot) {
+    // The previous token stays in a free slot, so bumping its generation never hands out a token still held by someone
+    return ((entry->token & ~(deferred_token)TOKEN_SLOT_MASK) + (1 << TOKEN_SLOT_BITS)) | (deferred_token)(slot + 1);
+}
+
+static inline void release_entry(deferred_executor_t *entry) {
+    entry->trigger_time = 0;
+    entry->callback     = NULL;
+    entry->cb_arg       = NULL;
 }
 
 //------------------------------------
@@ -45,26 +52,20 @@ static inline deferred_token allocate_token(deferred_executor_t *table, size_t t
 
 deferred_token defer_exec_advanced(deferred_executor_t *table, size_t table_count, uint32_t delay_ms, deferred_exec_callback callback, void *cb_arg) {
     // Ignore queueing if the table isn't valid, it's a zero-time delay, or the token is not valid
-    if (!table || table_count == 0 || delay_ms == 0 || !callback) {
+    if (!table || table_count == 0 || table_count > DEFERRED_EXEC_MAX_TABLE_SIZE || delay_ms == 0 || !callback) {
         return INVALID_DEFERRED_TOKEN;
     }
 
     // Find an unused slot and claim it
-    for (int i = 0; i < table_count; ++i) {
+    for (size_t i = 0; i < table_count; ++i) {
         deferred_executor_t *entry = &table[i];
-        if (entry->token == INVALID_DEFERRED_TOKEN) {
-            // Work out the new token value, dropping out if none were available
-            deferred_token token = allocate_token(table, table_count);
-            if (token == INVALID_DEFERRED_TOKEN) {
-                return false;
-            }
-
+        if (!entry_is_active(entry)) {
             // Set up the executor table entry
-            entry->token        = current_token;
+            entry->token        = allocate_token(entry, i);
             entry->trigger_time = timer_read32() + delay_ms;
             entry->callback     = callback;
             entry->cb_arg       = cb_arg;
-            return current_token;
+            return entry->token;
         }
     }
 
@@ -74,45 +75,52 @@ deferred_token defer_exec_advanced(deferred_executor_t *table, size_t table_coun
 
 bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token, uint32_t delay_ms) {
     // Ignore queueing if the table isn't valid, it's a zero-time delay, or the token is not valid
-    if (!table || table_count == 0 || delay_ms == 0 || token == INVALID_DEFERRED_TOKEN) {
+    if (!table || delay_ms == 0) {
         return false;
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, extend the delay
-            entry->trigger_time = timer_read32() + delay_ms;
-            return true;
-        }
+    deferred_executor_t *entry = find_entry(table, table_count, token);
+    if (!entry) {
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, extend the delay
+    entry->trigger_time = timer_read32() + delay_ms;
+    return true;
 }
 
 bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token) {
-    // Ignore request if the table/token are not valid
-    if (!table || table_count == 0 || token == INVALID_DEFERRED_TOKEN) {
+    // Ignore request if the table is not valid
+    if (!table) {
         return false;
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
+    deferred_executor_t *entry = find_entry(table, table_count, token);
+    if (!entry) {
+        return false;
+    }
+
+    // Found it, clear the table entry -- the token is kept so that the slot's next token differs
+    release_entry(entry);
+    return true;
+}
+
+bool deferred_exec_advanced_next_trigger(deferred_executor_t *table, size_t table_count, uint32_t *trigger_time) {
+    bool found = false;
+    if (!table) {
+        return false;
+    }
+
+    for (size_t i = 0; i < table_count; ++i) {
         deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, cancel and clear the table entry
-            entry->token        = INVALID_DEFERRED_TOKEN;
-            entry->trigger_time = 0;
-            entry->callback     = NULL;
-            entry->cb_arg       = NULL;
-            return true;
+        if (entry_is_active(entry) && (!found || ((int32_t)TIMER_DIFF_32(entry->trigger_time, *trigger_time)) < 0)) {
+            *trigger_time = entry->trigger_time;
+            found         = true;
         }
     }
-
-    // Not found
-    return false;
+    return found;
 }
 
 void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time) {
@@ -123,17 +131,17 @@ void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count,
         *last_execution_time = now;
 
         // Run through each of the executors
-        for (int i = 0; i < table_count; ++i) {
+        for (size_t i = 0; i < table_count; ++i) {
             deferred_executor_t *entry      = &table[i];
             deferred_token       curr_token = entry->token;
 
             // Check if we're supposed to execute this entry
-            if (curr_token != INVALID_DEFERRED_TOKEN && ((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) <= 0) {
+            if (entry_is_active(entry) && ((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) <= 0) {
                 // Invoke the callback and work work out if we should be requeued
                 uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
 
-                // If the token has changed, then the callback has canceled and re-queued. Skip further processing.
-                if (entry->token != curr_token) {
+                // If the token has changed or the entry is free, then the callback has canceled and possibly re-queued. Skip further processing.
+                if (entry->token != curr_token || !entry_is_active(entry)) {
                     continue;
                 }
 
@@ -146,10 +154,7 @@ void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count,
                     entry->trigger_time += delay_ms;
                 } else {
                     // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
-                    entry->token        = INVALID_DEFERRED_TOKEN;
-                    entry->trigger_time = 0;
-                    entry->callback     = NULL;
-                    entry->cb_arg       = NULL;
+                    release_entry(entry);
                 }
             }
         }
@@ -163,15 +168,48 @@ void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count,
 static uint32_t            last_deferred_exec_check                = 0;
 static deferred_executor_t basic_executors[MAX_DEFERRED_EXECUTORS] = {0};
 
+// Earliest trigger time of the basic table, which may be early after a cancellation but never late
+static bool     basic_pending      = false;
+static uint32_t basic_next_trigger = 0;
+
+static inline void basic_track_trigger(uint32_t trigger_time) {
+    if (!basic_pending || ((int32_t)TIMER_DIFF_32(trigger_time, basic_next_trigger)) < 0) {
+        basic_next_trigger = trigger_time;
+        basic_pending      = true;
+    }
+}
+
 deferred_token defer_exec(uint32_t delay_ms, deferred_exec_callback callback, void *cb_arg) {
-    return defer_exec_advanced(basic_executors, MAX_DEFERRED_EXECUTORS, delay_ms, callback, cb_arg);
+    uint32_t       trigger_time = timer_read32() + delay_ms;
+    deferred_token token        = defer_exec_advanced(basic_executors, MAX_DEFERRED_EXECUTORS, delay_ms, callback, cb_arg);
+    if (token != INVALID_DEFERRED_TOKEN) {
+        basic_track_trigger(trigger_time);
+    }
+    return token;
 }
 bool extend_deferred_exec(deferred_token token, uint32_t delay_ms) {
-    return extend_deferred_exec_advanced(basic_executors, MAX_DEFERRED_EXECUTORS, token, delay_ms);
+    uint32_t trigger_time = timer_read32() + delay_ms;
+    if (!extend_deferred_exec_advanced(basic_executors, MAX_DEFERRED_EXECUTORS, token, delay_ms)) {
+        return false;
+    }
+    basic_track_trigger(trigger_time);
+    return true;
 }
 bool cancel_deferred_exec(deferred_token token) {
     return cancel_deferred_exec_advanced(basic_executors, MAX_DEFERRED_EXECUTORS, token);
 }
+bool deferred_exec_next_trigger(uint32_t *trigger_time) {
+    if (basic_pending) {
+        *trigger_time = basic_next_trigger;
+    }
+    return basic_pending;
+}
 void deferred_exec_task(void) {
+    // Skip walking the table until something is due
+    if (!basic_pending || ((int32_t)TIMER_DIFF_32(basic_next_trigger, timer_read32())) > 0) {
+        return;
+    }
+
     deferred_exec_advanced_task(basic_executors, MAX_DEFERRED_EXECUTORS, &last_deferred_exec_check);
+    basic_pending = deferred_exec_advanced_next_trigger(basic_executors, MAX_DEFERRED_EXECUTORS, &basic_next_trigger);
 }
@@ -13,14 +13,21 @@
 
 /**
  * @typedef A token that can be used to cancel or extend an existing deferred execution.
+ * @brief The low byte holds the table slot, the remaining bits a generation counter for that slot, so a token is never
+ *        handed out again while an older copy of it could still be in use.
  */
-typedef uint8_t deferred_token;
+typedef uint32_t deferred_token;
 
 /**
  * @def The constant used to denote an invalid deferred execution token.
  */
 #define INVALID_DEFERRED_TOKEN 0
 
+/**
+ * @def The maximum number of entries in a deferred executor table, limited by the slot bits of a deferred_token.
+ */
+#define DEFERRED_EXEC_MAX_TABLE_SIZE 255
+
 /**
  * @typedef Callback to execute.
  * @param trigger_time[in] the intended trigger time to execute the callback -- equivalent time-space as timer_read32()
@@ -65,6 +72,14 @@ bool cancel_deferred_exec(deferred_token token);
  */
 void deferred_exec_task(void);
 
+/**
+ * Retrieves the time at which the next deferred execution is due, so that the main loop can idle until then.
+ *
+ * @param trigger_time[out] the trigger time of the earliest pending executor -- equivalent time-space as timer_read32()
+ * @return true if an execution is pending, otherwise false
+ */
+bool deferred_exec_next_trigger(uint32_t *trigger_time);
+
 //------------------------------------
 // Advanced API: used when a custom-allocated table is used, primarily for core code.
 //------------------------------------
@@ -73,6 +88,7 @@ void deferred_exec_task(void);
  * @struct Structure for containing self-hosted deferred executor tables.
  * @brief Core-side code can use this to create their own tables without impacting on the use of users' ability to add deferred execution.
  *        Code outside deferred_exec.c should not worry about internals of this struct, and should just allocate the required number in an array.
+ *        Tables may hold at most DEFERRED_EXEC_MAX_TABLE_SIZE entries.
  */
 typedef struct deferred_executor_t {
     deferred_token         token;
@@ -110,6 +126,16 @@ bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
  */
 bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token);
 
+/**
+ * Retrieves the time at which the next deferred execution in a custom table is due.
+ *
+ * @param table[in] the custom table used for storage
+ * @param table_count[in] the number of available items in the table
+ * @param trigger_time[out] the trigger time of the earliest pending executor -- equivalent time-space as timer_read32()
+ * @return true if an execution is pending, otherwise false
+ */
+bool deferred_exec_advanced_next_trigger(deferred_executor_t *table, size_t table_count, uint32_t *trigger_time);
+
 /**
  * Forward declaration for the main loop in order to execute any custom table deferred executors. Should not be invoked by keyboard/user code.
  * Needed for any custom-allocated deferred execution tables. Any core tasks should add appropriate invocation to quantum/main.c.
@@ -38,6 +38,13 @@ void dynamic_keymap_reset(void);
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 
+// With DYNAMIC_KEYMAP_RAM_CACHE, keymaps, encoders and macros are read from a
+// RAM mirror and writes are committed to EEPROM once no further writes happened
+// for DYNAMIC_KEYMAP_FLUSH_TIMEOUT milliseconds, or when flushed explicitly.
+// Both are no-ops otherwise.
+void dynamic_keymap_flush(void);
+void dynamic_keymap_task(void);
+
 // This overrides the one in quantum/keymap_common.c
 // uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key);
 
@@ -16,6 +16,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include <stdint.h>
+#include <string.h>
 #include "keyboard.h"
 #include "keycode_config.h"
 #include "matrix.h"
@@ -80,6 +81,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef KEY_OVERRIDE_ENABLE
 #    include "process_key_override.h"
 #endif
+#ifdef SEND_STRING_ENABLE
+#    include "send_string.h"
+#endif
+#ifdef DYNAMIC_MACRO_ENABLE
+#    include "process_dynamic_macro.h"
+#endif
 #ifdef SECURE_ENABLE
 #    include "secure.h"
 #endif
@@ -104,6 +111,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef VIA_ENABLE
 #    include "via.h"
 #endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#    include "dynamic_keymap.h"
+#endif
 #ifdef DIP_SWITCH_ENABLE
 #    include "dip_switch.h"
 #endif
@@ -140,6 +150,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef OS_DETECTION_ENABLE
 #    include "os_detection.h"
 #endif
+#ifdef I2C_ASYNC_ENABLE
+#    include "i2c_async.h"
+#endif
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) {
@@ -520,6 +533,65 @@ static inline void generate_tick_event(void) {
     }
 }
 
+#if (defined(SEND_STRING_ENABLE) && defined(SEND_STRING_NONBLOCKING)) || (defined(DYNAMIC_MACRO_ENABLE) && defined(DYNAMIC_MACRO_NONBLOCKING))
+#    define HOLD_KEY_EVENTS_DURING_PLAYBACK
+#    ifndef HELD_KEY_EVENTS_SIZE
+#        define HELD_KEY_EVENTS_SIZE 8
+#    endif
+
+/* Key events that happened while a string or macro was being played back. */
+static keyevent_t held_key_events[HELD_KEY_EVENTS_SIZE];
+static uint8_t    held_key_events_count = 0;
+
+static bool playback_is_running(void) {
+#    if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_NONBLOCKING)
+    if (send_string_is_busy()) {
+        return true;
+    }
+#    endif
+#    if defined(DYNAMIC_MACRO_ENABLE) && defined(DYNAMIC_MACRO_NONBLOCKING)
+    if (dynamic_macro_is_playing()) {
+        return true;
+    }
+#    endif
+    return false;
+}
+
+/**
+ * @brief Processes the held key events once the playback has ended, in the
+ * order they happened. Stops again if one of them starts another playback.
+ */
+static void held_key_events_task(void) {
+    uint8_t processed = 0;
+    while (processed < held_key_events_count && !playback_is_running()) {
+        action_exec(held_key_events[processed++]);
+    }
+
+    held_key_events_count -= processed;
+    memmove(held_key_events, &held_key_events[processed], held_key_events_count * sizeof(keyevent_t));
+}
+#endif
+
+/**
+ * @brief Processes a key event, or holds it back until the string or macro
+ * being played back has been sent, so that they don't mix.
+ *
+ * @return false The event could not be held and has to be retried later
+ */
+static inline bool process_key_event(keyevent_t event) {
+#ifdef HOLD_KEY_EVENTS_DURING_PLAYBACK
+    if (held_key_events_count > 0 || playback_is_running()) {
+        if (held_key_events_count == HELD_KEY_EVENTS_SIZE) {
+            return false;
+        }
+        held_key_events[held_key_events_count++] = event;
+        return true;
+    }
+#endif
+    action_exec(event);
+    return true;
+}
+
 /**
  * @brief This task scans the keyboards matrix and processes any key presses
  * that occur.
@@ -528,18 +600,28 @@ static inline void generate_tick_event(void) {
  * @return false Matrix didn't change
  */
 static bool matrix_task(void) {
+#ifdef HOLD_KEY_EVENTS_DURING_PLAYBACK
+    held_key_events_task();
+#endif
+
     if (!matrix_can_read()) {
         generate_tick_event();
         return false;
     }
 
     static matrix_row_t matrix_previous[MATRIX_ROWS];
+    matrix_row_t        matrix_changes[MATRIX_ROWS];
 
     matrix_scan();
-    bool matrix_changed = false;
-    for (uint8_t row = 0; row < MATRIX_ROWS && !matrix_changed; row++) {
-        matrix_changed |= matrix_previous[row] ^ matrix_get_row(row);
+
+    // Record the per row changes in a single pass, rows without changes are
+    // skipped entirely afterwards
+    matrix_row_t any_changes = 0;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        matrix_changes[row] = matrix_previous[row] ^ matrix_get_row(row);
+        any_changes |= matrix_changes[row];
     }
+    const bool matrix_changed = any_changes != 0;
 
     matrix_scan_perf_task();
 
@@ -556,27 +638,36 @@ static bool matrix_task(void) {
     const bool process_keypress = should_process_keypress();
 
     for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
-        const matrix_row_t current_row = matrix_get_row(row);
-        const matrix_row_t row_changes = current_row ^ matrix_previous[row];
+        matrix_row_t row_changes = matrix_changes[row];
+        if (!row_changes) {
+            continue;
+        }
 
-        if (!row_changes || has_ghost_in_row(row, current_row)) {
+        const matrix_row_t current_row = matrix_previous[row] ^ row_changes;
+        if (has_ghost_in_row(row, current_row)) {
             continue;
         }
 
+        // Changes that couldn't be processed yet are left for the next scan
+        matrix_row_t deferred = 0;
+
+        // Stop as soon as the last changed column has been handled
         matrix_row_t col_mask = 1;
-        for (uint8_t col = 0; col < MATRIX_COLS; col++, col_mask <<= 1) {
+        for (uint8_t col = 0; col < MATRIX_COLS && row_changes; col++, col_mask <<= 1) {
             if (row_changes & col_mask) {
                 const bool key_pressed = current_row & col_mask;
+                row_changes &= ~col_mask;
 
-                if (process_keypress) {
-                    action_exec(MAKE_KEYEVENT(row, col, key_pressed));
+                if (process_keypress && !process_key_event(MAKE_KEYEVENT(row, col, key_pressed))) {
+                    deferred |= col_mask;
+                    continue;
                 }
 
                 switch_events(row, col, key_pressed);
             }
         }
 
-        matrix_previous[row] = current_row;
+        matrix_previous[row] = current_row ^ deferred;
     }
 
     return matrix_changed;
@@ -620,6 +711,14 @@ void quantum_task(void) {
     key_override_task();
 #endif
 
+#if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_NONBLOCKING)
+    send_string_task();
+#endif
+
+#if defined(DYNAMIC_MACRO_ENABLE) && defined(DYNAMIC_MACRO_NONBLOCKING)
+    dynamic_macro_task();
+#endif
+
 #ifdef SEQUENCER_ENABLE
     sequencer_task();
 #endif
@@ -671,6 +770,14 @@ void keyboard_task(void) {
     split_watchdog_task();
 #endif
 
+#ifdef DYNAMIC_KEYMAP_ENABLE
+    dynamic_keymap_task();
+#endif
+
+#ifdef I2C_ASYNC_ENABLE
+    i2c_async_task();
+#endif
+
 #if defined(RGBLIGHT_ENABLE)
     rgblight_task();
 #endif
@@ -67,6 +67,9 @@ uint8_t g_led_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
 last_hit_t g_last_hit_tracker;
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
+#ifdef LED_MATRIX_LED_DISTANCE_TABLE
+uint8_t g_led_led_distance[LED_MATRIX_LED_DISTANCE_TABLE_SIZE];
+#endif // LED_MATRIX_LED_DISTANCE_TABLE
 
 // internals
 static bool            suspend_state     = false;
@@ -78,7 +81,19 @@ static led_task_states led_task_state    = SYNCING;
 // double buffers
 static uint32_t led_timer_buffer;
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
-static last_hit_t last_hit_buffer;
+// Ring buffer of the hits, oldest first, with the time they happened at.
+// g_last_hit_tracker is filled from it at the start of every frame.
+static struct {
+    uint8_t  head;
+    uint8_t  count;
+    uint8_t  index[LED_HITS_TO_REMEMBER];
+    uint32_t time[LED_HITS_TO_REMEMBER];
+} last_hit_buffer;
+
+static inline uint8_t last_hit_slot(uint8_t i) {
+    uint16_t slot = last_hit_buffer.head + i;
+    return slot < LED_HITS_TO_REMEMBER ? slot : slot - LED_HITS_TO_REMEMBER;
+}
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
 
 // split led matrix
@@ -177,21 +192,17 @@ void process_led_matrix(uint8_t row, uint8_t col, bool pressed) {
         led_count = led_matrix_map_row_column_to_led(row, col, led);
     }
 
-    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
-    }
-
+    uint32_t time = sync_timer_read32();
     for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
-        last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
-        last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
-        last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
-        last_hit_buffer.count++;
+        uint8_t slot = last_hit_slot(last_hit_buffer.count);
+        if (last_hit_buffer.count < LED_HITS_TO_REMEMBER) {
+            last_hit_buffer.count++;
+        } else {
+            // The buffer is full, the oldest hit is overwritten
+            last_hit_buffer.head = last_hit_slot(1);
+        }
+        last_hit_buffer.index[slot] = led[i];
+        last_hit_buffer.time[slot]  = time;
     }
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
 
@@ -212,24 +223,31 @@ static bool led_matrix_none(effect_params_t *params) {
 }
 
 static void led_task_timers(void) {
-#if defined(LED_MATRIX_KEYREACTIVE_ENABLED)
-    uint32_t deltaTime = sync_timer_elapsed32(led_timer_buffer);
-#endif // defined(LED_MATRIX_KEYREACTIVE_ENABLED)
     led_timer_buffer = sync_timer_read32();
 
-    // Update double buffer last hit timers
+    // Drop the hits whose tick would overflow, they are the oldest ones
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
-    uint8_t count = last_hit_buffer.count;
-    for (uint8_t i = 0; i < count; ++i) {
-        if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
-            last_hit_buffer.count--;
-            continue;
-        }
-        last_hit_buffer.tick[i] += deltaTime;
+    while (last_hit_buffer.count > 0 && led_timer_buffer - last_hit_buffer.time[last_hit_buffer.head] > UINT16_MAX) {
+        last_hit_buffer.head = last_hit_slot(1);
+        last_hit_buffer.count--;
     }
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
 }
 
+#ifdef LED_MATRIX_KEYREACTIVE_ENABLED
+static void led_task_update_last_hit_tracker(void) {
+    g_last_hit_tracker.count = last_hit_buffer.count;
+    for (uint8_t i = 0; i < last_hit_buffer.count; i++) {
+        uint8_t slot                = last_hit_slot(i);
+        uint8_t led                 = last_hit_buffer.index[slot];
+        g_last_hit_tracker.x[i]     = g_led_config.point[led].x;
+        g_last_hit_tracker.y[i]     = g_led_config.point[led].y;
+        g_last_hit_tracker.index[i] = led;
+        g_last_hit_tracker.tick[i]  = g_led_timer - last_hit_buffer.time[slot];
+    }
+}
+#endif // LED_MATRIX_KEYREACTIVE_ENABLED
+
 static void led_task_sync(void) {
     eeconfig_flush_led_matrix(false);
     // next task
@@ -243,7 +261,7 @@ static void led_task_start(void) {
     // update double buffers
     g_led_timer = led_timer_buffer;
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker = last_hit_buffer;
+    led_task_update_last_hit_tracker();
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
 
     // next task
@@ -410,19 +428,34 @@ struct led_matrix_limits_t led_matrix_get_limits(uint8_t iter) {
     return limits;
 }
 
+#ifdef LED_MATRIX_LED_DISTANCE_TABLE
+void led_matrix_update_led_distances(void) {
+    uint16_t k = 0;
+    for (uint8_t a = 0; a < LED_MATRIX_LED_COUNT; a++) {
+        for (uint8_t b = 0; b <= a; b++) {
+            int16_t dx                = g_led_config.point[a].x - g_led_config.point[b].x;
+            int16_t dy                = g_led_config.point[a].y - g_led_config.point[b].y;
+            g_led_led_distance[k++] = sqrt16(dx * dx + dy * dy);
+        }
+    }
+}
+#endif // LED_MATRIX_LED_DISTANCE_TABLE
+
 void led_matrix_init(void) {
     led_matrix_driver.init();
 
+#ifdef LED_MATRIX_LED_DISTANCE_TABLE
+    led_matrix_update_led_distances();
+#endif // LED_MATRIX_LED_DISTANCE_TABLE
+
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
     for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
         g_last_hit_tracker.tick[i] = UINT16_MAX;
     }
 
+    last_hit_buffer.head  = 0;
     last_hit_buffer.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        last_hit_buffer.tick[i] = UINT16_MAX;
-    }
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
 
     eeconfig_init_led_matrix();
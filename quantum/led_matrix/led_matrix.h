@@ -86,8 +86,14 @@ struct led_matrix_limits_t led_matrix_get_limits(uint8_t iter);
 
 #define LED_MATRIX_USE_LIMITS(min, max) LED_MATRIX_USE_LIMITS_ITER(min, max, params->iter)
 
-#define LED_MATRIX_TEST_LED_FLAGS() \
-    if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) continue
+#ifdef LED_MATRIX_LED_FLAGS_UNIFORM
+// Every LED has these flags, so the test is the same for all of them
+#    define LED_MATRIX_TEST_LED_FLAGS() \
+        if (!HAS_ANY_FLAGS(LED_MATRIX_LED_FLAGS_UNIFORM, params->flags)) continue
+#else
+#    define LED_MATRIX_TEST_LED_FLAGS() \
+        if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) continue
+#endif
 
 enum led_matrix_effects {
     LED_MATRIX_NONE = 0,
@@ -198,3 +204,20 @@ extern last_hit_t g_last_hit_tracker;
 #ifdef LED_MATRIX_FRAMEBUFFER_EFFECTS
 extern uint8_t g_led_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
 #endif
+#ifdef LED_MATRIX_LED_DISTANCE_TABLE
+#    define LED_MATRIX_LED_DISTANCE_TABLE_SIZE (LED_MATRIX_LED_COUNT * (LED_MATRIX_LED_COUNT + 1) / 2)
+extern uint8_t g_led_led_distance[LED_MATRIX_LED_DISTANCE_TABLE_SIZE];
+
+void led_matrix_update_led_distances(void);
+
+/* Distance between the points of two LEDs, as sqrt16(dx * dx + dy * dy).
+ * Only one half of the symmetric table is stored. */
+static inline uint8_t led_matrix_led_distance(uint8_t led_a, uint8_t led_b) {
+    if (led_a < led_b) {
+        uint8_t tmp = led_a;
+        led_a       = led_b;
+        led_b       = tmp;
+    }
+    return g_led_led_distance[(uint16_t)led_a * (led_a + 1) / 2 + led_b];
+}
+#endif
@@ -198,6 +198,25 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     current_matrix[current_row] = current_row_value;
 }
 
+#            ifdef MATRIX_FAST_IDLE_SCAN
+static bool matrix_any_key_down(void) {
+    // Select every row at once, any pressed key pulls its col low
+    for (uint8_t x = 0; x < ROWS_PER_HAND; x++) {
+        select_row(x);
+    }
+    matrix_output_select_delay();
+
+    bool key_pressed = false;
+    for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++) {
+        key_pressed |= readMatrixPin(col_pins[col_index]) == 0;
+    }
+
+    unselect_rows();
+    matrix_output_unselect_delay(0, key_pressed);
+    return key_pressed;
+}
+#            endif
+
 #        elif (DIODE_DIRECTION == ROW2COL)
 
 static bool select_col(uint8_t col) {
@@ -262,6 +281,25 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
     matrix_output_unselect_delay(current_col, key_pressed); // wait for all Row signals to go HIGH
 }
 
+#            ifdef MATRIX_FAST_IDLE_SCAN
+static bool matrix_any_key_down(void) {
+    // Select every col at once, any pressed key pulls its row low
+    for (uint8_t x = 0; x < MATRIX_COLS; x++) {
+        select_col(x);
+    }
+    matrix_output_select_delay();
+
+    bool key_pressed = false;
+    for (uint8_t row_index = 0; row_index < ROWS_PER_HAND; row_index++) {
+        key_pressed |= readMatrixPin(row_pins[row_index]) == 0;
+    }
+
+    unselect_cols();
+    matrix_output_unselect_delay(0, key_pressed);
+    return key_pressed;
+}
+#            endif
+
 #        else
 #            error DIODE_DIRECTION must be one of COL2ROW or ROW2COL!
 #        endif
@@ -320,21 +358,39 @@ __attribute__((weak)) bool transport_master_if_connected(matrix_row_t master_mat
 }
 #endif
 
+static bool matrix_scan_needed(void) {
+#if defined(MATRIX_FAST_IDLE_SCAN) && !defined(DIRECT_PINS) && defined(MATRIX_ROW_PINS) && defined(MATRIX_COL_PINS)
+    // While keys are held down every line has to be scanned to track them
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        if (raw_matrix[row]) {
+            return true;
+        }
+    }
+
+    // Otherwise a single read with all lines selected tells if anything got pressed
+    return matrix_any_key_down();
+#else
+    return true;
+#endif
+}
+
 uint8_t matrix_scan(void) {
     matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
 
+    if (matrix_scan_needed()) {
 #if defined(DIRECT_PINS) || (DIODE_DIRECTION == COL2ROW)
-    // Set row, read cols
-    for (uint8_t current_row = 0; current_row < ROWS_PER_HAND; current_row++) {
-        matrix_read_cols_on_row(curr_matrix, current_row);
-    }
+        // Set row, read cols
+        for (uint8_t current_row = 0; current_row < ROWS_PER_HAND; current_row++) {
+            matrix_read_cols_on_row(curr_matrix, current_row);
+        }
 #elif (DIODE_DIRECTION == ROW2COL)
-    // Set col, read rows
-    matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
-    for (uint8_t current_col = 0; current_col < MATRIX_COLS; current_col++, row_shifter <<= 1) {
-        matrix_read_rows_on_col(curr_matrix, current_col, row_shifter);
-    }
+        // Set col, read rows
+        matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
+        for (uint8_t current_col = 0; current_col < MATRIX_COLS; current_col++, row_shifter <<= 1) {
+            matrix_read_rows_on_col(curr_matrix, current_col, row_shifter);
+        }
 #endif
+    }
 
     bool changed = memcmp(raw_matrix, curr_matrix, sizeof(curr_matrix)) != 0;
     if (changed) memcpy(raw_matrix, curr_matrix, sizeof(curr_matrix));
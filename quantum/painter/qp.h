@@ -72,6 +72,25 @@
 #    define QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE 1024
 #endif
 
+#ifndef QUANTUM_PAINTER_SPI_ASYNC_TRANSFERS
+/**
+ * @def This controls whether SPI displays are sent pixel data with asynchronous DMA transfers on ChibiOS. Each block is
+ *      copied into one of two transfer buffers, so the next block is decoded while the previous one is still on the wire.
+ *      Requires twice QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE of extra RAM.
+ */
+#    define QUANTUM_PAINTER_SPI_ASYNC_TRANSFERS FALSE
+#endif
+
+#ifndef QUANTUM_PAINTER_DECODE_SPAN_SIZE
+/**
+ * @def This controls the number of pixels decoded, or bytes of panel-native data read, at a time when drawing images
+ *      and fonts. Each decoded span is handed to the driver in one go, larger spans mean fewer calls at the cost of
+ *      stack space (two bytes per pixel). Must be a multiple of 8.
+ */
+#    define QUANTUM_PAINTER_DECODE_SPAN_SIZE 64
+#endif
+_Static_assert((QUANTUM_PAINTER_DECODE_SPAN_SIZE > 0) && (QUANTUM_PAINTER_DECODE_SPAN_SIZE % 8) == 0, "QUANTUM_PAINTER_DECODE_SPAN_SIZE needs to be a non-zero multiple of 8");
+
 #ifndef QUANTUM_PAINTER_SUPPORTS_256_PALETTE
 /**
  * @def This controls whether 256-color palettes are supported. This has relatively hefty requirements on RAM -- at
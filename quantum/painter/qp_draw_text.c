@@ -339,12 +339,11 @@ static inline bool qp_font_code_point_handler_calcwidth(qff_font_handle_t *qff_f
 
 // Callback state
 typedef struct code_point_iter_drawglyph_state_t {
-    painter_device_t                  device;
-    int16_t                           xpos;
-    int16_t                           ypos;
-    qp_internal_byte_input_callback   input_callback;
-    qp_internal_byte_input_state_t *  input_state;
-    qp_internal_pixel_output_state_t *output_state;
+    painter_device_t                device;
+    int16_t                         xpos;
+    int16_t                         ypos;
+    qp_internal_byte_input_callback input_callback;
+    qp_internal_byte_input_state_t *input_state;
 } code_point_iter_drawglyph_state_t;
 
 // Codepoint handler callback: drawing
@@ -355,9 +354,6 @@ static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_f
     // Reset the input state's RLE mode -- the stream should already be correctly positioned by qp_iterate_code_points()
     state->input_state->rle.mode = MARKER_BYTE; // ignored if not using RLE
 
-    // Reset the output state
-    state->output_state->pixel_write_pos = 0;
-
     // Configure where we're going to be rendering to
     driver->driver_vtable->viewport(state->device, state->xpos, state->ypos, state->xpos + width - 1, state->ypos + height - 1);
 
@@ -425,9 +421,6 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
         return false;
     }
 
-    // Set up the pixel output state
-    qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
-
     // Set up the codepoint iteration state
     code_point_iter_drawglyph_state_t state = {// Common
                                                .device = device,
@@ -435,9 +428,7 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
                                                .ypos   = y,
                                                // Input
                                                .input_callback = input_callback,
-                                               .input_state    = &input_state,
-                                               // Output
-                                               .output_state = &output_state};
+                                               .input_state    = &input_state};
 
     qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
     qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
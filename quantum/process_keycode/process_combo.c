@@ -16,6 +16,7 @@
 
 #include "process_combo.h"
 #include <stddef.h>
+#include <string.h>
 #include "process_auto_shift.h"
 #include "caps_word.h"
 #include "timer.h"
@@ -94,6 +95,19 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
 
 #define INCREMENT_MOD(i) i = (i + 1) % COMBO_BUFFER_LENGTH
 
+#ifdef COMBO_LOOKUP_INDEX
+typedef struct {
+    uint16_t keycode;
+    uint16_t combo_index;
+} combo_index_entry_t;
+/* Every (keycode, combo) pair, sorted by keycode and then by combo index. */
+static combo_index_entry_t combo_lookup_index[COMBO_LOOKUP_INDEX_LENGTH];
+static uint16_t            combo_lookup_index_size  = 0;
+static uint16_t            combo_lookup_index_count = 0;
+static bool                combo_lookup_index_built = false;
+static bool                combo_lookup_index_valid = false;
+#endif
+
 #ifndef EXTRA_SHORT_COMBOS
 /* flags are their own elements in combo_t struct. */
 #    define COMBO_ACTIVE(combo) (combo->active)
@@ -256,7 +270,6 @@ static inline void dump_key_buffer(void) {
     key_buffer_next = key_buffer_size = 0;
 }
 
-#define NO_COMBO_KEYS_ARE_DOWN (0 == COMBO_STATE(combo))
 #define ALL_COMBO_KEYS_ARE_DOWN(state, key_count) (((1 << key_count) - 1) == state)
 #define ONLY_ONE_KEY_IS_DOWN(state) !(state & (state - 1))
 #define KEY_NOT_YET_RELEASED(state, key_index) ((1 << key_index) & state)
@@ -392,6 +405,60 @@ combo_t *overlaps(combo_t *combo1, combo_t *combo2) {
     return combo1;
 }
 
+#ifdef COMBO_LOOKUP_INDEX
+static void build_combo_lookup_index(void) {
+    combo_lookup_index_size  = 0;
+    combo_lookup_index_count = combo_count();
+    combo_lookup_index_built = true;
+    combo_lookup_index_valid = true;
+
+    for (uint16_t combo_index = 0; combo_index < combo_lookup_index_count; ++combo_index) {
+        const uint16_t *keys = combo_get(combo_index)->keys;
+        uint16_t        key;
+
+        for (uint8_t key_index = 0; (key = pgm_read_word(&keys[key_index])) != COMBO_END; ++key_index) {
+            /* Insert after all entries with the same keycode, combos are visited
+             * in order so this keeps entries sorted by combo index as well. */
+            uint16_t pos = combo_lookup_index_size;
+            while (pos > 0 && combo_lookup_index[pos - 1].keycode > key) {
+                pos--;
+            }
+
+            if (pos > 0 && combo_lookup_index[pos - 1].keycode == key && combo_lookup_index[pos - 1].combo_index == combo_index) {
+                // same key listed twice in a combo
+                continue;
+            }
+
+            if (combo_lookup_index_size >= COMBO_LOOKUP_INDEX_LENGTH) {
+                // index too small, fall back to checking every combo
+                combo_lookup_index_valid = false;
+                return;
+            }
+
+            memmove(&combo_lookup_index[pos + 1], &combo_lookup_index[pos], (combo_lookup_index_size - pos) * sizeof(combo_index_entry_t));
+            combo_lookup_index[pos] = (combo_index_entry_t){
+                .keycode     = key,
+                .combo_index = combo_index,
+            };
+            combo_lookup_index_size++;
+        }
+    }
+}
+
+static uint16_t find_first_combo_lookup_index_entry(uint16_t keycode) {
+    uint16_t low = 0, high = combo_lookup_index_size;
+    while (low < high) {
+        uint16_t mid = low + (high - low) / 2;
+        if (combo_lookup_index[mid].keycode < keycode) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+#endif
+
 #if defined(COMBO_MUST_PRESS_IN_ORDER) || defined(COMBO_MUST_PRESS_IN_ORDER_PER_COMBO)
 static bool keys_pressed_in_order(uint16_t combo_index, combo_t *combo, uint16_t key_index, uint16_t keycode, keyrecord_t *record) {
 #    ifdef COMBO_MUST_PRESS_IN_ORDER_PER_COMBO
@@ -535,8 +602,7 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
 }
 
 bool process_combo(uint16_t keycode, keyrecord_t *record) {
-    bool is_combo_key          = false;
-    bool no_combo_keys_pressed = true;
+    bool is_combo_key = false;
 
     if (keycode == QK_COMBO_ON && record->event.pressed) {
         combo_enable();
@@ -564,10 +630,23 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#ifdef COMBO_LOOKUP_INDEX
+    if (!combo_lookup_index_built || combo_lookup_index_count != combo_count()) {
+        build_combo_lookup_index();
+    }
+
+    if (combo_lookup_index_valid) {
+        /* Only the combos containing this keycode need to be processed. */
+        for (uint16_t i = find_first_combo_lookup_index_entry(keycode); i < combo_lookup_index_size && combo_lookup_index[i].keycode == keycode; ++i) {
+            uint16_t idx = combo_lookup_index[i].combo_index;
+            is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+        }
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+            is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
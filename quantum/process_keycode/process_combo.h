@@ -38,6 +38,9 @@
 #ifndef COMBO_BUFFER_LENGTH
 #    define COMBO_BUFFER_LENGTH 4
 #endif
+#ifndef COMBO_LOOKUP_INDEX_LENGTH
+#    define COMBO_LOOKUP_INDEX_LENGTH 256
+#endif
 
 typedef struct combo_t {
     const uint16_t *keys;
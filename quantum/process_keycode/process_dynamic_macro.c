@@ -22,6 +22,12 @@
 #include "keycodes.h"
 #include "debug.h"
 #include "wait.h"
+#ifdef DYNAMIC_MACRO_NONBLOCKING
+#    include "timer.h"
+#    if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_NONBLOCKING)
+#        include "send_string.h"
+#    endif
+#endif
 
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
@@ -81,14 +87,49 @@ void dynamic_macro_record_start(keyrecord_t **macro_pointer, keyrecord_t *macro_
     *macro_pointer = macro_buffer;
 }
 
+#ifdef DYNAMIC_MACRO_NONBLOCKING
+#    ifdef DYNAMIC_MACRO_DELAY
+#        define DYNAMIC_MACRO_PLAYBACK_DELAY DYNAMIC_MACRO_DELAY
+#    else
+#        define DYNAMIC_MACRO_PLAYBACK_DELAY 0
+#    endif
+
+/* The macro being played back by dynamic_macro_task(), NULL if none. */
+static keyrecord_t  *playback_pointer = NULL;
+static keyrecord_t  *playback_end;
+static int8_t        playback_direction;
+static layer_state_t playback_saved_layer_state;
+/* When the last record was played. */
+static uint32_t playback_time;
+#endif
+
+static void dynamic_macro_play_end(layer_state_t saved_layer_state, int8_t direction) {
+    clear_keyboard();
+
+    layer_state_set(saved_layer_state);
+
+    dynamic_macro_play_user(direction);
+}
+
 /**
  * Play the dynamic macro.
  *
+ * With DYNAMIC_MACRO_NONBLOCKING, the playback is only started here
+ * and the records are played by dynamic_macro_task(). Playing a macro
+ * while another one is being played back is ignored.
+ *
  * @param macro_buffer[in] The beginning of the macro buffer being played.
  * @param macro_end[in]    The element after the last macro buffer element.
  * @param direction[in]    Either +1 or -1, which way to iterate the buffer.
  */
 void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_t direction) {
+#ifdef DYNAMIC_MACRO_NONBLOCKING
+    if (playback_pointer != NULL) {
+        dprintln("dynamic macro: already playing back, ignored");
+        return;
+    }
+#endif
+
     dprintf("dynamic macro: slot %d playback\n", DYNAMIC_MACRO_CURRENT_SLOT());
 
     layer_state_t saved_layer_state = layer_state;
@@ -96,21 +137,52 @@ void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_
     clear_keyboard();
     layer_clear();
 
+#ifdef DYNAMIC_MACRO_NONBLOCKING
+    playback_pointer           = macro_buffer;
+    playback_end               = macro_end;
+    playback_direction         = direction;
+    playback_saved_layer_state = saved_layer_state;
+    playback_time              = timer_read32() - DYNAMIC_MACRO_PLAYBACK_DELAY;
+#else
     while (macro_buffer != macro_end) {
         process_record(macro_buffer);
         macro_buffer += direction;
-#ifdef DYNAMIC_MACRO_DELAY
+#    ifdef DYNAMIC_MACRO_DELAY
         wait_ms(DYNAMIC_MACRO_DELAY);
-#endif
+#    endif
     }
 
-    clear_keyboard();
+    dynamic_macro_play_end(saved_layer_state, direction);
+#endif
+}
 
-    layer_state_set(saved_layer_state);
+#ifdef DYNAMIC_MACRO_NONBLOCKING
+void dynamic_macro_task(void) {
+    while (playback_pointer != NULL && timer_elapsed32(playback_time) >= DYNAMIC_MACRO_PLAYBACK_DELAY) {
+#    if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_NONBLOCKING)
+        // Let a string sent by the last record be typed out first
+        if (send_string_is_busy()) {
+            return;
+        }
+#    endif
+        if (playback_pointer == playback_end) {
+            playback_pointer = NULL;
+            dynamic_macro_play_end(playback_saved_layer_state, playback_direction);
+            return;
+        }
 
-    dynamic_macro_play_user(direction);
+        keyrecord_t *record = playback_pointer;
+        playback_pointer += playback_direction;
+        process_record(record);
+        playback_time = timer_read32();
+    }
 }
 
+bool dynamic_macro_is_playing(void) {
+    return playback_pointer != NULL;
+}
+#endif
+
 /**
  * Record a single key in a dynamic macro.
  *
@@ -42,3 +42,7 @@ void dynamic_macro_play_user(int8_t direction);
 void dynamic_macro_record_key_user(int8_t direction, keyrecord_t *record);
 void dynamic_macro_record_end_user(int8_t direction);
 void dynamic_macro_stop_recording(void);
+#ifdef DYNAMIC_MACRO_NONBLOCKING
+void dynamic_macro_task(void);
+bool dynamic_macro_is_playing(void);
+#endif
@@ -22,6 +22,10 @@
 #include "action.h"
 #include "action_layer.h"
 
+#ifndef KEY_OVERRIDE_LOOKUP_INDEX_LENGTH
+#    define KEY_OVERRIDE_LOOKUP_INDEX_LENGTH 64
+#endif
+
 /**
  * Key overrides allow you to send a different key-modifier combination or perform a custom action when a certain modifier-key combination is pressed.
  *
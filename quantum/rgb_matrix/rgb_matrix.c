@@ -69,6 +69,9 @@ uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 last_hit_t g_last_hit_tracker;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+#ifdef RGB_MATRIX_LED_DISTANCE_TABLE
+uint8_t g_rgb_led_distance[RGB_MATRIX_LED_DISTANCE_TABLE_SIZE];
+#endif // RGB_MATRIX_LED_DISTANCE_TABLE
 
 // internals
 static bool            suspend_state     = false;
@@ -77,10 +80,31 @@ static uint8_t         rgb_last_effect   = UINT8_MAX;
 static effect_params_t rgb_effect_params = {0, LED_FLAG_ALL, false};
 static rgb_task_states rgb_task_state    = SYNCING;
 
+// static effect frame skipping
+static HSV     rgb_last_hsv;
+static uint8_t rgb_last_speed;
+static HSV     rgb_frame_hsv;
+static uint8_t rgb_frame_speed;
+static bool    rgb_effect_drawing = false;
+static bool    rgb_foreign_drawn  = true;
+static bool    rgb_frame_skipped  = false;
+
 // double buffers
 static uint32_t rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-static last_hit_t last_hit_buffer;
+// Ring buffer of the hits, oldest first, with the time they happened at.
+// g_last_hit_tracker is filled from it at the start of every frame.
+static struct {
+    uint8_t  head;
+    uint8_t  count;
+    uint8_t  index[LED_HITS_TO_REMEMBER];
+    uint32_t time[LED_HITS_TO_REMEMBER];
+} last_hit_buffer;
+
+static inline uint8_t last_hit_slot(uint8_t i) {
+    uint16_t slot = last_hit_buffer.head + i;
+    return slot < LED_HITS_TO_REMEMBER ? slot : slot - LED_HITS_TO_REMEMBER;
+}
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
 // split rgb matrix
@@ -144,10 +168,12 @@ void rgb_matrix_update_pwm_buffers(void) {
 }
 
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    if (!rgb_effect_drawing) rgb_foreign_drawn = true;
     rgb_matrix_driver.set_color(index, red, green, blue);
 }
 
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+    if (!rgb_effect_drawing) rgb_foreign_drawn = true;
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
     for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
         rgb_matrix_set_color(i, red, green, blue);
@@ -174,21 +200,17 @@ void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
         led_count = rgb_matrix_map_row_column_to_led(row, col, led);
     }
 
-    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
-    }
-
+    uint32_t time = sync_timer_read32();
     for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
-        last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
-        last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
-        last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
-        last_hit_buffer.count++;
+        uint8_t slot = last_hit_slot(last_hit_buffer.count);
+        if (last_hit_buffer.count < LED_HITS_TO_REMEMBER) {
+            last_hit_buffer.count++;
+        } else {
+            // The buffer is full, the oldest hit is overwritten
+            last_hit_buffer.head = last_hit_slot(1);
+        }
+        last_hit_buffer.index[slot] = led[i];
+        last_hit_buffer.time[slot]  = time;
     }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
@@ -239,39 +261,78 @@ static bool rgb_matrix_none(effect_params_t *params) {
     return false;
 }
 
+static bool rgb_matrix_effect_is_static(uint8_t effect) {
+    // Effects that only depend on the rgb config and the LED layout,
+    // but not on time, key hits or host state.
+    switch (effect) {
+        case RGB_MATRIX_SOLID_COLOR:
+#ifdef ENABLE_RGB_MATRIX_ALPHAS_MODS
+        case RGB_MATRIX_ALPHAS_MODS:
+#endif
+#ifdef ENABLE_RGB_MATRIX_GRADIENT_UP_DOWN
+        case RGB_MATRIX_GRADIENT_UP_DOWN:
+#endif
+#ifdef ENABLE_RGB_MATRIX_GRADIENT_LEFT_RIGHT
+        case RGB_MATRIX_GRADIENT_LEFT_RIGHT:
+#endif
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool rgb_matrix_frame_unchanged(uint8_t effect) {
+    // Anything drawn outside of the effect (indicators, user code) has to be
+    // painted over again, so only skip if the effect was the sole writer.
+    return !rgb_foreign_drawn && rgb_matrix_effect_is_static(effect) && effect == rgb_last_effect && rgb_matrix_config.enable == rgb_last_enable && rgb_matrix_config.flags == rgb_effect_params.flags && rgb_matrix_config.speed == rgb_last_speed && rgb_matrix_config.hsv.h == rgb_last_hsv.h && rgb_matrix_config.hsv.s == rgb_last_hsv.s && rgb_matrix_config.hsv.v == rgb_last_hsv.v;
+}
+
 static void rgb_task_timers(void) {
-#if defined(RGB_MATRIX_KEYREACTIVE_ENABLED)
-    uint32_t deltaTime = sync_timer_elapsed32(rgb_timer_buffer);
-#endif // defined(RGB_MATRIX_KEYREACTIVE_ENABLED)
     rgb_timer_buffer = sync_timer_read32();
 
-    // Update double buffer last hit timers
+    // Drop the hits whose tick would overflow, they are the oldest ones
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    uint8_t count = last_hit_buffer.count;
-    for (uint8_t i = 0; i < count; ++i) {
-        if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
-            last_hit_buffer.count--;
-            continue;
-        }
-        last_hit_buffer.tick[i] += deltaTime;
+    while (last_hit_buffer.count > 0 && rgb_timer_buffer - last_hit_buffer.time[last_hit_buffer.head] > UINT16_MAX) {
+        last_hit_buffer.head = last_hit_slot(1);
+        last_hit_buffer.count--;
     }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 }
 
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+static void rgb_task_update_last_hit_tracker(void) {
+    g_last_hit_tracker.count = last_hit_buffer.count;
+    for (uint8_t i = 0; i < last_hit_buffer.count; i++) {
+        uint8_t slot                = last_hit_slot(i);
+        uint8_t led                 = last_hit_buffer.index[slot];
+        g_last_hit_tracker.x[i]     = g_led_config.point[led].x;
+        g_last_hit_tracker.y[i]     = g_led_config.point[led].y;
+        g_last_hit_tracker.index[i] = led;
+        g_last_hit_tracker.tick[i]  = g_rgb_timer - last_hit_buffer.time[slot];
+    }
+}
+#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+
 static void rgb_task_sync(void) {
     eeconfig_flush_rgb_matrix(false);
     // next task
     if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
 }
 
-static void rgb_task_start(void) {
+static void rgb_task_start(uint8_t effect) {
     // reset iter
     rgb_effect_params.iter = 0;
 
+    // the driver buffers still hold the last frame of a static effect
+    rgb_frame_skipped = rgb_matrix_frame_unchanged(effect);
+    rgb_foreign_drawn = false;
+    rgb_frame_hsv     = rgb_matrix_config.hsv;
+    rgb_frame_speed   = rgb_matrix_config.speed;
+
     // update double buffers
     g_rgb_timer = rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker = last_hit_buffer;
+    rgb_task_update_last_hit_tracker();
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
     // next task
@@ -286,6 +347,16 @@ static void rgb_task_render(uint8_t effect) {
         rgb_matrix_set_color_all(0, 0, 0);
     }
 
+    if (rgb_frame_skipped && effect == rgb_last_effect) {
+        // still step through the iterations so indicators can draw every LED
+        RGB_MATRIX_USE_LIMITS_ITER(led_min, led_max, rgb_effect_params.iter);
+        rgb_effect_params.iter++;
+        if (!rgb_matrix_check_finished_leds(led_max)) rgb_task_state = FLUSHING;
+        return;
+    }
+
+    rgb_effect_drawing = true;
+
     // each effect can opt to do calculations
     // and/or request PWM buffer updates.
     switch (effect) {
@@ -323,9 +394,11 @@ static void rgb_task_render(uint8_t effect) {
             rgb_matrix_test();
             rgb_task_state = FLUSHING;
         }
+            rgb_effect_drawing = false;
             return;
     }
 
+    rgb_effect_drawing = false;
     rgb_effect_params.iter++;
 
     // next task
@@ -342,6 +415,8 @@ static void rgb_task_flush(uint8_t effect) {
     // update last trackers after the first full render so we can init over several frames
     rgb_last_effect = effect;
     rgb_last_enable = rgb_matrix_config.enable;
+    rgb_last_hsv    = rgb_frame_hsv;
+    rgb_last_speed  = rgb_frame_speed;
 
     // update pwm buffers
     rgb_matrix_update_pwm_buffers();
@@ -365,7 +440,7 @@ void rgb_matrix_task(void) {
 
     switch (rgb_task_state) {
         case STARTING:
-            rgb_task_start();
+            rgb_task_start(effect);
             break;
         case RENDERING:
             rgb_task_render(effect);
@@ -445,19 +520,34 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
     return true;
 }
 
+#ifdef RGB_MATRIX_LED_DISTANCE_TABLE
+void rgb_matrix_update_led_distances(void) {
+    uint16_t k = 0;
+    for (uint8_t a = 0; a < RGB_MATRIX_LED_COUNT; a++) {
+        for (uint8_t b = 0; b <= a; b++) {
+            int16_t dx                = g_led_config.point[a].x - g_led_config.point[b].x;
+            int16_t dy                = g_led_config.point[a].y - g_led_config.point[b].y;
+            g_rgb_led_distance[k++] = sqrt16(dx * dx + dy * dy);
+        }
+    }
+}
+#endif // RGB_MATRIX_LED_DISTANCE_TABLE
+
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
 
+#ifdef RGB_MATRIX_LED_DISTANCE_TABLE
+    rgb_matrix_update_led_distances();
+#endif // RGB_MATRIX_LED_DISTANCE_TABLE
+
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
     for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
         g_last_hit_tracker.tick[i] = UINT16_MAX;
     }
 
+    last_hit_buffer.head  = 0;
     last_hit_buffer.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        last_hit_buffer.tick[i] = UINT16_MAX;
-    }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
     eeconfig_init_rgb_matrix();
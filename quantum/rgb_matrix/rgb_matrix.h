@@ -111,8 +111,14 @@ struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter);
         rgb_matrix_set_color(i, r, g, b);          \
     }
 
-#define RGB_MATRIX_TEST_LED_FLAGS() \
-    if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) continue
+#ifdef RGB_MATRIX_LED_FLAGS_UNIFORM
+// Every LED has these flags, so the test is the same for all of them
+#    define RGB_MATRIX_TEST_LED_FLAGS() \
+        if (!HAS_ANY_FLAGS(RGB_MATRIX_LED_FLAGS_UNIFORM, params->flags)) continue
+#else
+#    define RGB_MATRIX_TEST_LED_FLAGS() \
+        if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) continue
+#endif
 
 enum rgb_matrix_effects {
     RGB_MATRIX_NONE = 0,
@@ -277,3 +283,20 @@ extern last_hit_t g_last_hit_tracker;
 #ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
 extern uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
 #endif
+#ifdef RGB_MATRIX_LED_DISTANCE_TABLE
+#    define RGB_MATRIX_LED_DISTANCE_TABLE_SIZE (RGB_MATRIX_LED_COUNT * (RGB_MATRIX_LED_COUNT + 1) / 2)
+extern uint8_t g_rgb_led_distance[RGB_MATRIX_LED_DISTANCE_TABLE_SIZE];
+
+void rgb_matrix_update_led_distances(void);
+
+/* Distance between the points of two LEDs, as sqrt16(dx * dx + dy * dy).
+ * Only one half of the symmetric table is stored. */
+static inline uint8_t rgb_matrix_led_distance(uint8_t led_a, uint8_t led_b) {
+    if (led_a < led_b) {
+        uint8_t tmp = led_a;
+        led_a       = led_b;
+        led_b       = tmp;
+    }
+    return g_rgb_led_distance[(uint16_t)led_a * (led_a + 1) / 2 + led_b];
+}
+#endif
@@ -23,6 +23,11 @@
 #include "keycode.h"
 #include "action.h"
 #include "wait.h"
+#ifdef SEND_STRING_NONBLOCKING
+#    include <string.h>
+#    include "timer.h"
+#    include "debug.h"
+#endif
 
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
 #    include "audio.h"
@@ -143,63 +148,109 @@ __attribute__((weak)) const uint8_t ascii_to_keycode_lut[128] PROGMEM = {
 
 // clang-format on
 
-// Note: we bit-pack in "reverse" order to optimize loading
-#define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
+#ifdef SEND_STRING_NONBLOCKING
+#    ifndef SEND_STRING_BUFFER_SIZE
+#        define SEND_STRING_BUFFER_SIZE 64
+#    endif
 
-void send_string(const char *string) {
-    send_string_with_delay(string, TAP_CODE_DELAY);
+typedef enum {
+    SEND_STRING_OP_WAIT,
+    SEND_STRING_OP_REGISTER,
+    SEND_STRING_OP_UNREGISTER,
+    SEND_STRING_OP_BELL,
+} send_string_action_t;
+
+typedef struct {
+    uint8_t  action;
+    uint8_t  keycode;
+    uint32_t delay; // ms to wait after the action
+} send_string_op_t;
+
+/* A queued string, and how far it has been typed. */
+typedef struct {
+    const char *string;
+    uint8_t     interval;
+    bool        progmem;
+} send_string_source_t;
+
+static send_string_source_t send_string_queue[SEND_STRING_QUEUE_SIZE];
+static uint8_t              send_string_queue_head  = 0;
+static uint8_t              send_string_queue_count = 0;
+// Strings in RAM are copied, as the caller's buffer may be gone by the time they are typed
+static char     send_string_buffer[SEND_STRING_BUFFER_SIZE];
+static uint16_t send_string_buffer_used = 0;
+
+// The key events of the character being typed. A character takes at most
+// eight: Shift, AltGr, the key itself and a dead key space, pressed and released.
+#    define SEND_STRING_OPS_SIZE 8
+static send_string_op_t send_string_ops[SEND_STRING_OPS_SIZE];
+static uint8_t          send_string_ops_index = 0;
+static uint8_t          send_string_ops_count = 0;
+// The last op played, and how long to wait after it
+static uint32_t send_string_last_time = 0;
+static uint32_t send_string_wait      = 0;
+
+static void send_string_enqueue_op(uint8_t action, uint8_t keycode) {
+    if (send_string_ops_count < SEND_STRING_OPS_SIZE) {
+        send_string_ops[send_string_ops_count++] = (send_string_op_t){
+            .action  = action,
+            .keycode = keycode,
+            .delay   = 0,
+        };
+    }
 }
 
-void send_string_with_delay(const char *string, uint8_t interval) {
-    while (1) {
-        char ascii_code = *string;
-        if (!ascii_code) break;
-        if (ascii_code == SS_QMK_PREFIX) {
-            ascii_code = *(++string);
-
-            if (ascii_code == SS_TAP_CODE) {
-                // tap
-                uint8_t keycode = *(++string);
-                tap_code(keycode);
-            } else if (ascii_code == SS_DOWN_CODE) {
-                // down
-                uint8_t keycode = *(++string);
-                register_code(keycode);
-            } else if (ascii_code == SS_UP_CODE) {
-                // up
-                uint8_t keycode = *(++string);
-                unregister_code(keycode);
-            } else if (ascii_code == SS_DELAY_CODE) {
-                // delay
-                int     ms      = 0;
-                uint8_t keycode = *(++string);
-
-                while (isdigit(keycode)) {
-                    ms *= 10;
-                    ms += keycode - '0';
-                    keycode = *(++string);
-                }
-
-                wait_ms(ms);
-            }
+/* Delays are added to the op before them, only a delay with nothing queued takes an op of its own. */
+static void send_string_enqueue_wait(uint32_t ms) {
+    if (ms == 0) {
+        return;
+    }
+    if (send_string_ops_count == 0) {
+        send_string_enqueue_op(SEND_STRING_OP_WAIT, KC_NO);
+    }
+    send_string_ops[send_string_ops_count - 1].delay += ms;
+}
 
-            wait_ms(interval);
-        } else {
-            send_char_with_delay(ascii_code, interval);
-        }
+static void string_register_code(uint8_t keycode) {
+    send_string_enqueue_op(SEND_STRING_OP_REGISTER, keycode);
+}
 
-        ++string;
-    }
+static void string_unregister_code(uint8_t keycode) {
+    send_string_enqueue_op(SEND_STRING_OP_UNREGISTER, keycode);
 }
 
-void send_char(char ascii_code) {
-    send_char_with_delay(ascii_code, TAP_CODE_DELAY);
+static void string_wait_ms(uint32_t ms) {
+    send_string_enqueue_wait(ms);
 }
 
-void send_char_with_delay(char ascii_code, uint8_t interval) {
+static void string_tap_code_delay(uint8_t keycode, uint16_t delay) {
+    string_register_code(keycode);
+    string_wait_ms(delay);
+    string_unregister_code(keycode);
+}
+
+static void string_tap_code(uint8_t keycode) {
+    string_tap_code_delay(keycode, keycode == KC_CAPS_LOCK ? TAP_HOLD_CAPS_DELAY : TAP_CODE_DELAY);
+}
+#else
+#    define string_register_code register_code
+#    define string_unregister_code unregister_code
+#    define string_wait_ms wait_ms
+#    define string_tap_code_delay tap_code_delay
+#    define string_tap_code tap_code
+#endif
+
+// Note: we bit-pack in "reverse" order to optimize loading
+#define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
+
+static void string_send_char(char ascii_code, uint8_t interval) {
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
     if (ascii_code == '\a') { // BEL
+#    ifdef SEND_STRING_NONBLOCKING
+        send_string_enqueue_op(SEND_STRING_OP_BELL, KC_NO);
+#    else
         PLAY_SONG(bell_song);
+#    endif
         return;
     }
 #endif
@@ -210,32 +261,262 @@ void send_char_with_delay(char ascii_code, uint8_t interval) {
     bool    is_dead    = PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code);
 
     if (is_shifted) {
-        register_code(KC_LEFT_SHIFT);
-        wait_ms(interval);
+        string_register_code(KC_LEFT_SHIFT);
+        string_wait_ms(interval);
     }
 
     if (is_altgred) {
-        register_code(KC_RIGHT_ALT);
-        wait_ms(interval);
+        string_register_code(KC_RIGHT_ALT);
+        string_wait_ms(interval);
     }
 
-    tap_code_delay(keycode, interval);
-    wait_ms(interval);
+    string_tap_code_delay(keycode, interval);
+    string_wait_ms(interval);
 
     if (is_altgred) {
-        unregister_code(KC_RIGHT_ALT);
-        wait_ms(interval);
+        string_unregister_code(KC_RIGHT_ALT);
+        string_wait_ms(interval);
     }
 
     if (is_shifted) {
-        unregister_code(KC_LEFT_SHIFT);
-        wait_ms(interval);
+        string_unregister_code(KC_LEFT_SHIFT);
+        string_wait_ms(interval);
     }
 
     if (is_dead) {
-        tap_code(KC_SPACE);
-        wait_ms(interval);
+        string_tap_code(KC_SPACE);
+        string_wait_ms(interval);
+    }
+}
+
+static inline char send_string_read(const char *string, bool progmem) {
+    return progmem ? pgm_read_byte(string) : *string;
+}
+
+/**
+ * Types the character or key code sequence at the start of the string.
+ *
+ * @return The rest of the string, or NULL at the end of the string.
+ */
+static const char *send_string_decode(const char *string, uint8_t interval, bool progmem) {
+    char ascii_code = send_string_read(string, progmem);
+    if (!ascii_code) return NULL;
+    if (ascii_code == SS_QMK_PREFIX) {
+        ascii_code = send_string_read(++string, progmem);
+
+        if (ascii_code == SS_TAP_CODE) {
+            // tap
+            uint8_t keycode = send_string_read(++string, progmem);
+            string_tap_code(keycode);
+        } else if (ascii_code == SS_DOWN_CODE) {
+            // down
+            uint8_t keycode = send_string_read(++string, progmem);
+            string_register_code(keycode);
+        } else if (ascii_code == SS_UP_CODE) {
+            // up
+            uint8_t keycode = send_string_read(++string, progmem);
+            string_unregister_code(keycode);
+        } else if (ascii_code == SS_DELAY_CODE) {
+            // delay
+            int     ms      = 0;
+            uint8_t keycode = send_string_read(++string, progmem);
+
+            while (isdigit(keycode)) {
+                ms *= 10;
+                ms += keycode - '0';
+                keycode = send_string_read(++string, progmem);
+            }
+
+            string_wait_ms(ms);
+        }
+
+        string_wait_ms(interval);
+    } else if (progmem) {
+        string_send_char(ascii_code, TAP_CODE_DELAY);
+        // interval
+        string_wait_ms(interval);
+    } else {
+        string_send_char(ascii_code, interval);
     }
+
+    return ++string;
+}
+
+#ifdef SEND_STRING_NONBLOCKING
+static send_string_source_t *send_string_queue_at(uint8_t index) {
+    return &send_string_queue[(send_string_queue_head + index) % SEND_STRING_QUEUE_SIZE];
+}
+
+/* Moves the copied strings that are left to the start of the buffer. */
+static void send_string_buffer_compact(void) {
+    uint16_t offset = send_string_buffer_used;
+    for (uint8_t i = 0; i < send_string_queue_count; i++) {
+        send_string_source_t *source = send_string_queue_at(i);
+        if (!source->progmem) {
+            offset = source->string - send_string_buffer;
+            break;
+        }
+    }
+
+    memmove(send_string_buffer, &send_string_buffer[offset], send_string_buffer_used - offset);
+    send_string_buffer_used -= offset;
+    for (uint8_t i = 0; i < send_string_queue_count; i++) {
+        send_string_source_t *source = send_string_queue_at(i);
+        if (!source->progmem) {
+            source->string -= offset;
+        }
+    }
+}
+
+/* Plays the next op of the queued strings, waiting for it if it isn't due yet. */
+static void send_string_step(void) {
+    uint32_t elapsed = timer_elapsed32(send_string_last_time);
+    if (elapsed < send_string_wait) {
+        wait_ms(send_string_wait - elapsed);
+    }
+    send_string_task();
+}
+
+/*
+ * Queues a string. If the queue is full, the queued strings are typed out
+ * until there is room, rather than dropping the string, so that a long string
+ * sent in parts, like a VIA macro, is never cut short.
+ */
+static void send_string_enqueue(const char *string, uint8_t interval, bool progmem) {
+    if (progmem) {
+        while (send_string_queue_count == SEND_STRING_QUEUE_SIZE) {
+            send_string_step();
+        }
+        *send_string_queue_at(send_string_queue_count++) = (send_string_source_t){.string = string, .interval = interval, .progmem = true};
+        return;
+    }
+
+    if (strlen(string) + 1 > SEND_STRING_BUFFER_SIZE) {
+        // Too long to ever be copied, type it out from the caller's buffer
+        send_string_flush();
+        *send_string_queue_at(send_string_queue_count++) = (send_string_source_t){.string = string, .interval = interval, .progmem = false};
+        send_string_flush();
+        return;
+    }
+
+    while (true) {
+        // A copy is appended to the last queued copy if they are typed the same way
+        send_string_source_t *tail   = send_string_queue_count ? send_string_queue_at(send_string_queue_count - 1) : NULL;
+        bool                  append = tail && !tail->progmem && tail->interval == interval;
+        uint16_t              length = strlen(string) + (append ? 0 : 1);
+        if (send_string_buffer_used + length > SEND_STRING_BUFFER_SIZE) {
+            send_string_buffer_compact();
+        }
+        if (send_string_buffer_used + length <= SEND_STRING_BUFFER_SIZE && (append || send_string_queue_count < SEND_STRING_QUEUE_SIZE)) {
+            char *copy = &send_string_buffer[send_string_buffer_used - (append ? 1 : 0)];
+            memcpy(copy, string, strlen(string) + 1);
+            send_string_buffer_used += length;
+            if (!append) {
+                *send_string_queue_at(send_string_queue_count++) = (send_string_source_t){.string = copy, .interval = interval, .progmem = false};
+            }
+            return;
+        }
+        send_string_step();
+    }
+}
+
+/* Decodes the next character of the queued strings into ops. */
+static bool send_string_decode_next(void) {
+    send_string_ops_index = 0;
+    send_string_ops_count = 0;
+
+    while (send_string_queue_count > 0) {
+        send_string_source_t *source = send_string_queue_at(0);
+        const char           *next   = send_string_decode(source->string, source->interval, source->progmem);
+        if (next != NULL) {
+            source->string = next;
+            return true;
+        }
+
+        send_string_queue_head = (send_string_queue_head + 1) % SEND_STRING_QUEUE_SIZE;
+        send_string_queue_count--;
+        if (send_string_queue_count == 0) {
+            send_string_buffer_used = 0;
+        }
+    }
+    return false;
+}
+
+static void send_string_run_op(void) {
+    send_string_op_t op = send_string_ops[send_string_ops_index++];
+
+    switch (op.action) {
+        case SEND_STRING_OP_REGISTER:
+            register_code(op.keycode);
+            break;
+        case SEND_STRING_OP_UNREGISTER:
+            unregister_code(op.keycode);
+            break;
+#    if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+        case SEND_STRING_OP_BELL:
+            PLAY_SONG(bell_song);
+            break;
+#    endif
+    }
+
+    send_string_last_time = timer_read32();
+    send_string_wait      = op.delay;
+}
+
+static bool send_string_op_is_due(void) {
+    return timer_elapsed32(send_string_last_time) >= send_string_wait;
+}
+
+void send_string_task(void) {
+    while (send_string_op_is_due()) {
+        if (send_string_ops_index == send_string_ops_count && !send_string_decode_next()) {
+            return;
+        }
+        if (send_string_ops_index < send_string_ops_count) {
+            send_string_run_op();
+        }
+    }
+}
+
+void send_string_flush(void) {
+    while (send_string_is_busy()) {
+        send_string_step();
+    }
+}
+
+bool send_string_is_busy(void) {
+    return send_string_ops_index < send_string_ops_count || send_string_queue_count > 0;
+}
+#endif
+
+void send_string(const char *string) {
+    send_string_with_delay(string, TAP_CODE_DELAY);
+}
+
+void send_string_with_delay(const char *string, uint8_t interval) {
+#ifdef SEND_STRING_NONBLOCKING
+    send_string_enqueue(string, interval, false);
+#else
+    while ((string = send_string_decode(string, interval, false)) != NULL) {
+    }
+#endif
+}
+
+void send_char(char ascii_code) {
+    send_char_with_delay(ascii_code, TAP_CODE_DELAY);
+}
+
+void send_char_with_delay(char ascii_code, uint8_t interval) {
+#ifdef SEND_STRING_NONBLOCKING
+    // Queued as a one character string, which doesn't type anything for the prefix
+    if (ascii_code == SS_QMK_PREFIX) {
+        return;
+    }
+    const char string[2] = {ascii_code, '\0'};
+    send_string_enqueue(string, interval, false);
+#else
+    string_send_char(ascii_code, interval);
+#endif
 }
 
 void send_dword(uint32_t number) {
@@ -292,51 +573,17 @@ void tap_random_base64(void) {
     }
 }
 
-#if defined(__AVR__)
+#if defined(__AVR__) || defined(SEND_STRING_NONBLOCKING)
 void send_string_P(const char *string) {
     send_string_with_delay_P(string, 0);
 }
 
 void send_string_with_delay_P(const char *string, uint8_t interval) {
-    while (1) {
-        char ascii_code = pgm_read_byte(string);
-        if (!ascii_code) break;
-        if (ascii_code == SS_QMK_PREFIX) {
-            ascii_code = pgm_read_byte(++string);
-            if (ascii_code == SS_TAP_CODE) {
-                // tap
-                uint8_t keycode = pgm_read_byte(++string);
-                tap_code(keycode);
-            } else if (ascii_code == SS_DOWN_CODE) {
-                // down
-                uint8_t keycode = pgm_read_byte(++string);
-                register_code(keycode);
-            } else if (ascii_code == SS_UP_CODE) {
-                // up
-                uint8_t keycode = pgm_read_byte(++string);
-                unregister_code(keycode);
-            } else if (ascii_code == SS_DELAY_CODE) {
-                // delay
-                int     ms      = 0;
-                uint8_t keycode = pgm_read_byte(++string);
-                while (isdigit(keycode)) {
-                    ms *= 10;
-                    ms += keycode - '0';
-                    keycode = pgm_read_byte(++string);
-                }
-                while (ms--)
-                    wait_ms(1);
-            }
-        } else {
-            send_char(ascii_code);
-        }
-        ++string;
-        // interval
-        {
-            uint8_t ms = interval;
-            while (ms--)
-                wait_ms(1);
-        }
+#    ifdef SEND_STRING_NONBLOCKING
+    send_string_enqueue(string, interval, true);
+#    else
+    while ((string = send_string_decode(string, interval, true)) != NULL) {
     }
+#    endif
 }
 #endif
@@ -24,10 +24,15 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #include "progmem.h"
 #include "send_string_keycodes.h"
 
+#ifndef SEND_STRING_QUEUE_SIZE
+#    define SEND_STRING_QUEUE_SIZE 8
+#endif
+
 // Look-Up Tables (LUTs) to convert ASCII character to keycode sequence.
 extern const uint8_t ascii_to_shift_lut[16];
 extern const uint8_t ascii_to_altgr_lut[16];
@@ -123,12 +128,14 @@ void send_nibble(uint8_t number);
  */
 void tap_random_base64(void);
 
-#if defined(__AVR__) || defined(__DOXYGEN__)
+#if defined(__AVR__) || defined(SEND_STRING_NONBLOCKING) || defined(__DOXYGEN__)
 /**
  * \brief Type out a PROGMEM string of ASCII characters.
  *
  * On ARM devices, this function is simply an alias for send_string_with_delay(string, 0).
  *
+ * With `SEND_STRING_NONBLOCKING`, the string is not copied, so it has to stay valid until it has been typed out.
+ *
  * \param string The string to type out.
  */
 void send_string_P(const char *string);
@@ -138,6 +145,8 @@ void send_string_P(const char *string);
  *
  * On ARM devices, this function is simply an alias for send_string_with_delay(string, interval).
  *
+ * With `SEND_STRING_NONBLOCKING`, the string is not copied, so it has to stay valid until it has been typed out.
+ *
  * \param string The string to type out.
  * \param interval The amount of time, in milliseconds, to wait before typing the next character.
  */
@@ -147,6 +156,25 @@ void send_string_with_delay_P(const char *string, uint8_t interval);
 #    define send_string_with_delay_P(string, interval) send_string_with_delay(string, interval)
 #endif
 
+#if defined(SEND_STRING_NONBLOCKING) || defined(__DOXYGEN__)
+/**
+ * \brief Type out the queued strings, as far as their delays allow.
+ *
+ * With `SEND_STRING_NONBLOCKING`, the functions above queue the strings rather than typing them out, and return right away. This is called from the keyboard task to type them one character at a time.
+ */
+void send_string_task(void);
+
+/**
+ * \brief Type out all queued strings, waiting for their delays.
+ */
+void send_string_flush(void);
+
+/**
+ * \brief Whether there are queued strings left to type out.
+ */
+bool send_string_is_busy(void);
+#endif
+
 /**
  * \brief Shortcut macro for send_string_with_delay_P(PSTR(string), 0).
  *
@@ -21,15 +21,22 @@ enum serial_transaction_id {
     I2C_EXECUTE_CALLBACK,
 #endif // USE_I2C
 
+#ifdef SPLIT_TRANSPORT_COALESCE
+    GET_SLAVE_STATE,
+    PUT_MASTER_STATE_GET_SLAVE_STATE,
+#else // SPLIT_TRANSPORT_COALESCE
     GET_SLAVE_MATRIX_CHECKSUM,
     GET_SLAVE_MATRIX_DATA,
+#endif // SPLIT_TRANSPORT_COALESCE
 
 #ifdef SPLIT_TRANSPORT_MIRROR
     PUT_MASTER_MATRIX,
 #endif // SPLIT_TRANSPORT_MIRROR
 
 #ifdef ENCODER_ENABLE
+#    ifndef SPLIT_TRANSPORT_COALESCE
     GET_ENCODERS_CHECKSUM,
+#    endif // SPLIT_TRANSPORT_COALESCE
     GET_ENCODERS_DATA,
     CMD_ENCODER_DRAIN,
 #endif // ENCODER_ENABLE
@@ -38,18 +45,18 @@ enum serial_transaction_id {
     PUT_SYNC_TIMER,
 #endif // DISABLE_SYNC_TIMER
 
-#if !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
+#if !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE) && !defined(SPLIT_TRANSPORT_COALESCE)
     PUT_LAYER_STATE,
     PUT_DEFAULT_LAYER_STATE,
-#endif // !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
+#endif // !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE) && !defined(SPLIT_TRANSPORT_COALESCE)
 
-#ifdef SPLIT_LED_STATE_ENABLE
+#if defined(SPLIT_LED_STATE_ENABLE) && !defined(SPLIT_TRANSPORT_COALESCE)
     PUT_LED_STATE,
-#endif // SPLIT_LED_STATE_ENABLE
+#endif // defined(SPLIT_LED_STATE_ENABLE) && !defined(SPLIT_TRANSPORT_COALESCE)
 
-#ifdef SPLIT_MODS_ENABLE
+#if defined(SPLIT_MODS_ENABLE) && !defined(SPLIT_TRANSPORT_COALESCE)
     PUT_MODS,
-#endif // SPLIT_MODS_ENABLE
+#endif // defined(SPLIT_MODS_ENABLE) && !defined(SPLIT_TRANSPORT_COALESCE)
 
 #ifdef BACKLIGHT_ENABLE
     PUT_BACKLIGHT,
@@ -84,6 +84,9 @@
 #define trans_initiator2target_cb(cb) \
     { 0, 0, 0, 0, cb }
 
+#define trans_bidirectional_initializer(initiator2target_member, target2initiator_member) \
+    { sizeof_member(split_shared_memory_t, initiator2target_member), offsetof(split_shared_memory_t, initiator2target_member), sizeof_member(split_shared_memory_t, target2initiator_member), offsetof(split_shared_memory_t, target2initiator_member), NULL }
+
 #define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
 #define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
 #define transport_exec(id) transport_execute_transaction(id, NULL, 0, NULL, 0)
@@ -144,9 +147,7 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
         split_shared_memory_unlock();                         \
     } while (0)
 
-inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t trans_id_retrieve, uint32_t *last_update, void *destination, const void *equiv_shmem, size_t length) {
-    uint8_t curr_checksum;
-    bool    okay = transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
+inline static bool read_if_stale(bool okay, uint8_t curr_checksum, int8_t trans_id_retrieve, uint32_t *last_update, void *destination, const void *equiv_shmem, size_t length) {
     if (okay && (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || curr_checksum != crc8(equiv_shmem, length))) {
         okay &= transport_read(trans_id_retrieve, destination, length);
         okay &= curr_checksum == crc8(equiv_shmem, length);
@@ -159,6 +160,12 @@ inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t tr
     return okay;
 }
 
+inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t trans_id_retrieve, uint32_t *last_update, void *destination, const void *equiv_shmem, size_t length) {
+    uint8_t curr_checksum;
+    bool    okay = transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
+    return read_if_stale(okay, curr_checksum, trans_id_retrieve, last_update, destination, equiv_shmem, length);
+}
+
 inline static bool send_if_condition(int8_t trans_id, uint32_t *last_update, bool condition, void *source, size_t length) {
     bool okay = true;
     if (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || condition) {
@@ -178,6 +185,91 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
 ////////////////////////////////////////////////////
 // Slave matrix
 
+#ifdef SPLIT_TRANSPORT_COALESCE
+
+/**
+ * @brief Exchanges the coalesced split state. The master state is only sent
+ * when it changed (or on the forced sync interval), while the slave matrix and
+ * encoder checksum come back in the same transaction on every scan.
+ */
+static bool split_state_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint32_t           last_update                    = 0;
+    static matrix_row_t       last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
+    split_master_state_sync_t master_state;
+    split_slave_state_sync_t  slave_state;
+    bool                      okay;
+
+    // Clear the padding too, the payload is compared with memcmp
+    memset(&master_state, 0, sizeof(master_state));
+#    if !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
+    master_state.payload.layers.layer_state         = layer_state;
+    master_state.payload.layers.default_layer_state = default_layer_state;
+#    endif // !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
+#    ifdef SPLIT_LED_STATE_ENABLE
+    master_state.payload.led_state = host_keyboard_leds();
+#    endif // SPLIT_LED_STATE_ENABLE
+#    ifdef SPLIT_MODS_ENABLE
+    master_state.payload.mods.real_mods = get_mods();
+    master_state.payload.mods.weak_mods = get_weak_mods();
+#        ifndef NO_ACTION_ONESHOT
+    master_state.payload.mods.oneshot_mods = get_oneshot_mods();
+#        endif // NO_ACTION_ONESHOT
+#    endif     // SPLIT_MODS_ENABLE
+
+    if (timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS || memcmp(&master_state.payload, &split_shmem->master_state.payload, sizeof(master_state.payload)) != 0) {
+        master_state.version = split_shmem->master_state.version + 1;
+        okay                 = transport_execute_transaction(PUT_MASTER_STATE_GET_SLAVE_STATE, &master_state, sizeof(master_state), &slave_state, sizeof(slave_state));
+        if (okay) {
+            last_update = timer_read32();
+        }
+    } else {
+        okay = transport_read(GET_SLAVE_STATE, &slave_state, sizeof(slave_state));
+    }
+
+    okay = okay && slave_state.checksum == crc8(&slave_state, offsetof(split_slave_state_sync_t, checksum));
+    if (okay) {
+        // Checksum matches the received data, save as the last matrix state
+        memcpy(last_matrix, slave_state.matrix, sizeof(last_matrix));
+    }
+    // Copy out the last-known-good matrix state to the slave matrix
+    memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
+    return okay;
+}
+
+static void split_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint8_t last_version = 0;
+
+    memcpy(split_shmem->slave_state.matrix, slave_matrix, sizeof(split_shmem->slave_state.matrix));
+#    ifdef ENCODER_ENABLE
+    split_shmem->slave_state.encoder_checksum = split_shmem->encoders.checksum;
+#    endif // ENCODER_ENABLE
+    split_shmem->slave_state.checksum = crc8(&split_shmem->slave_state, offsetof(split_slave_state_sync_t, checksum));
+
+    // Unpack a new master state to where the individual slave handlers expect it
+    if (split_shmem->master_state.version != last_version) {
+        last_version = split_shmem->master_state.version;
+#    if !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
+        split_shmem->layers = split_shmem->master_state.payload.layers;
+#    endif // !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
+#    ifdef SPLIT_LED_STATE_ENABLE
+        split_shmem->led_state = split_shmem->master_state.payload.led_state;
+#    endif // SPLIT_LED_STATE_ENABLE
+#    ifdef SPLIT_MODS_ENABLE
+        split_shmem->mods = split_shmem->master_state.payload.mods;
+#    endif // SPLIT_MODS_ENABLE
+    }
+}
+
+// clang-format off
+#    define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(split_state)
+#    define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(split_state)
+#    define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
+    [GET_SLAVE_STATE]                  = trans_target2initiator_initializer(slave_state), \
+    [PUT_MASTER_STATE_GET_SLAVE_STATE] = trans_bidirectional_initializer(master_state, slave_state),
+// clang-format on
+
+#else // SPLIT_TRANSPORT_COALESCE
+
 static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t     last_update                    = 0;
     static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
@@ -199,13 +291,15 @@ static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row
 }
 
 // clang-format off
-#define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
-#define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
-#define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
+#    define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
     [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer(smatrix.checksum), \
     [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix),
 // clang-format on
 
+#endif // SPLIT_TRANSPORT_COALESCE
+
 ////////////////////////////////////////////////////
 // Master matrix
 
@@ -243,7 +337,13 @@ static bool encoder_handlers_master(matrix_row_t master_matrix[], matrix_row_t s
     static uint8_t   last_checksum = 0;
     encoder_events_t temp_events;
 
+#    ifdef SPLIT_TRANSPORT_COALESCE
+    // The checksum already arrived with the slave state
+    split_shmem->encoders.checksum = split_shmem->slave_state.encoder_checksum;
+    bool okay                      = read_if_stale(true, split_shmem->encoders.checksum, GET_ENCODERS_DATA, &last_update, &temp_events, &split_shmem->encoders.events, sizeof(temp_events));
+#    else
     bool okay = read_if_checksum_mismatch(GET_ENCODERS_CHECKSUM, GET_ENCODERS_DATA, &last_update, &temp_events, &split_shmem->encoders.events, sizeof(temp_events));
+#    endif // SPLIT_TRANSPORT_COALESCE
     if (okay) {
         if (last_checksum != split_shmem->encoders.checksum) {
             bool    actioned = false;
@@ -277,10 +377,16 @@ static void encoder_handlers_slave_drain(uint8_t initiator2target_buffer_size, c
 // clang-format off
 #    define TRANSACTIONS_ENCODERS_MASTER() TRANSACTION_HANDLER_MASTER(encoder)
 #    define TRANSACTIONS_ENCODERS_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(encoder)
-#    define TRANSACTIONS_ENCODERS_REGISTRATIONS \
+#    ifdef SPLIT_TRANSPORT_COALESCE
+#        define TRANSACTIONS_ENCODERS_REGISTRATIONS \
+    [GET_ENCODERS_DATA]     = trans_target2initiator_initializer(encoders.events), \
+    [CMD_ENCODER_DRAIN]     = trans_initiator2target_cb(encoder_handlers_slave_drain),
+#    else
+#        define TRANSACTIONS_ENCODERS_REGISTRATIONS \
     [GET_ENCODERS_CHECKSUM] = trans_target2initiator_initializer(encoders.checksum), \
     [GET_ENCODERS_DATA]     = trans_target2initiator_initializer(encoders.events), \
     [CMD_ENCODER_DRAIN]     = trans_initiator2target_cb(encoder_handlers_slave_drain),
+#    endif // SPLIT_TRANSPORT_COALESCE
 // clang-format on
 
 #else // ENCODER_ENABLE
@@ -335,6 +441,7 @@ static void sync_timer_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 
 #if !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
 
+#    ifndef SPLIT_TRANSPORT_COALESCE
 static bool layer_state_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t last_layer_state_update         = 0;
     static uint32_t last_default_layer_state_update = 0;
@@ -345,19 +452,26 @@ static bool layer_state_handlers_master(matrix_row_t master_matrix[], matrix_row
     }
     return okay;
 }
+#    endif // SPLIT_TRANSPORT_COALESCE
 
 static void layer_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     layer_state         = split_shmem->layers.layer_state;
     default_layer_state = split_shmem->layers.default_layer_state;
 }
 
-// clang-format off
-#    define TRANSACTIONS_LAYER_STATE_MASTER() TRANSACTION_HANDLER_MASTER(layer_state)
 #    define TRANSACTIONS_LAYER_STATE_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(layer_state)
-#    define TRANSACTIONS_LAYER_STATE_REGISTRATIONS \
+#    ifdef SPLIT_TRANSPORT_COALESCE
+// Sent as part of the coalesced master state
+#        define TRANSACTIONS_LAYER_STATE_MASTER()
+#        define TRANSACTIONS_LAYER_STATE_REGISTRATIONS
+#    else
+// clang-format off
+#        define TRANSACTIONS_LAYER_STATE_MASTER() TRANSACTION_HANDLER_MASTER(layer_state)
+#        define TRANSACTIONS_LAYER_STATE_REGISTRATIONS \
     [PUT_LAYER_STATE]         = trans_initiator2target_initializer(layers.layer_state), \
     [PUT_DEFAULT_LAYER_STATE] = trans_initiator2target_initializer(layers.default_layer_state),
 // clang-format on
+#    endif // SPLIT_TRANSPORT_COALESCE
 
 #else // !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
 
@@ -372,20 +486,28 @@ static void layer_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_
 
 #ifdef SPLIT_LED_STATE_ENABLE
 
+#    ifndef SPLIT_TRANSPORT_COALESCE
 static bool led_state_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t last_update = 0;
     uint8_t         led_state   = host_keyboard_leds();
     return send_if_data_mismatch(PUT_LED_STATE, &last_update, &led_state, &split_shmem->led_state, sizeof(led_state));
 }
+#    endif // SPLIT_TRANSPORT_COALESCE
 
 static void led_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     void set_split_host_keyboard_leds(uint8_t led_state);
     set_split_host_keyboard_leds(split_shmem->led_state);
 }
 
-#    define TRANSACTIONS_LED_STATE_MASTER() TRANSACTION_HANDLER_MASTER(led_state)
 #    define TRANSACTIONS_LED_STATE_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(led_state)
-#    define TRANSACTIONS_LED_STATE_REGISTRATIONS [PUT_LED_STATE] = trans_initiator2target_initializer(led_state),
+#    ifdef SPLIT_TRANSPORT_COALESCE
+// Sent as part of the coalesced master state
+#        define TRANSACTIONS_LED_STATE_MASTER()
+#        define TRANSACTIONS_LED_STATE_REGISTRATIONS
+#    else
+#        define TRANSACTIONS_LED_STATE_MASTER() TRANSACTION_HANDLER_MASTER(led_state)
+#        define TRANSACTIONS_LED_STATE_REGISTRATIONS [PUT_LED_STATE] = trans_initiator2target_initializer(led_state),
+#    endif // SPLIT_TRANSPORT_COALESCE
 
 #else // SPLIT_LED_STATE_ENABLE
 
@@ -400,6 +522,7 @@ static void led_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 
 #ifdef SPLIT_MODS_ENABLE
 
+#    ifndef SPLIT_TRANSPORT_COALESCE
 static bool mods_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t   last_update    = 0;
     bool              mods_need_sync = timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS;
@@ -431,6 +554,7 @@ static bool mods_handlers_master(matrix_row_t master_matrix[], matrix_row_t slav
 
     return okay;
 }
+#    endif // SPLIT_TRANSPORT_COALESCE
 
 static void mods_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     split_shared_memory_lock();
@@ -445,9 +569,15 @@ static void mods_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave
 #    endif
 }
 
-#    define TRANSACTIONS_MODS_MASTER() TRANSACTION_HANDLER_MASTER(mods)
 #    define TRANSACTIONS_MODS_SLAVE() TRANSACTION_HANDLER_SLAVE(mods)
-#    define TRANSACTIONS_MODS_REGISTRATIONS [PUT_MODS] = trans_initiator2target_initializer(mods),
+#    ifdef SPLIT_TRANSPORT_COALESCE
+// Sent as part of the coalesced master state
+#        define TRANSACTIONS_MODS_MASTER()
+#        define TRANSACTIONS_MODS_REGISTRATIONS
+#    else
+#        define TRANSACTIONS_MODS_MASTER() TRANSACTION_HANDLER_MASTER(mods)
+#        define TRANSACTIONS_MODS_REGISTRATIONS [PUT_MODS] = trans_initiator2target_initializer(mods),
+#    endif // SPLIT_TRANSPORT_COALESCE
 
 #else // SPLIT_MODS_ENABLE
 
@@ -972,9 +1102,10 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
 }
 
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    // encoders go first, their checksum is part of the coalesced slave state
+    TRANSACTIONS_ENCODERS_SLAVE();
     TRANSACTIONS_SLAVE_MATRIX_SLAVE();
     TRANSACTIONS_MASTER_MATRIX_SLAVE();
-    TRANSACTIONS_ENCODERS_SLAVE();
     TRANSACTIONS_SYNC_TIMER_SLAVE();
     TRANSACTIONS_LAYER_STATE_SLAVE();
     TRANSACTIONS_LED_STATE_SLAVE();
@@ -107,6 +107,14 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
         memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
     }
 
+#    ifdef SERIAL_PIPELINE_ENABLE
+    /* Nothing to wait for if the slave doesn't send anything back, the
+     * response is checked while the next transaction is underway. */
+    if (target2initiator_length == 0) {
+        return soft_serial_transaction_async(id);
+    }
+#    endif
+
     if (!soft_serial_transaction(id)) {
         return false;
     }
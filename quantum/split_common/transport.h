@@ -52,10 +52,12 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
 #    include "rgblight.h"
 #endif // RGBLIGHT_ENABLE
 
+#ifndef SPLIT_TRANSPORT_COALESCE
 typedef struct _split_slave_matrix_sync_t {
     uint8_t      checksum;
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
 } split_slave_matrix_sync_t;
+#endif // SPLIT_TRANSPORT_COALESCE
 
 #ifdef SPLIT_TRANSPORT_MIRROR
 typedef struct _split_master_matrix_sync_t {
@@ -105,6 +107,31 @@ typedef struct _split_mods_sync_t {
 } split_mods_sync_t;
 #endif // SPLIT_MODS_ENABLE
 
+#ifdef SPLIT_TRANSPORT_COALESCE
+typedef struct _split_slave_state_sync_t {
+    matrix_row_t matrix[(MATRIX_ROWS) / 2];
+#    ifdef ENCODER_ENABLE
+    uint8_t encoder_checksum;
+#    endif // ENCODER_ENABLE
+    uint8_t checksum;
+} split_slave_state_sync_t;
+
+typedef struct _split_master_state_sync_t {
+    uint8_t version;
+    struct {
+#    if !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
+        split_layers_sync_t layers;
+#    endif // !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
+#    ifdef SPLIT_LED_STATE_ENABLE
+        uint8_t led_state;
+#    endif // SPLIT_LED_STATE_ENABLE
+#    ifdef SPLIT_MODS_ENABLE
+        split_mods_sync_t mods;
+#    endif // SPLIT_MODS_ENABLE
+    } payload;
+} split_master_state_sync_t;
+#endif // SPLIT_TRANSPORT_COALESCE
+
 #if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
 #    include "pointing_device.h"
 typedef struct _split_slave_pointing_sync_t {
@@ -151,7 +178,12 @@ typedef struct _split_shared_memory_t {
     int8_t transaction_id;
 #endif // USE_I2C
 
+#ifdef SPLIT_TRANSPORT_COALESCE
+    split_slave_state_sync_t  slave_state;
+    split_master_state_sync_t master_state;
+#else // SPLIT_TRANSPORT_COALESCE
     split_slave_matrix_sync_t smatrix;
+#endif // SPLIT_TRANSPORT_COALESCE
 
 #ifdef SPLIT_TRANSPORT_MIRROR
     split_master_matrix_sync_t mmatrix;
@@ -63,4 +63,82 @@ wear_leveling_8byte_SRC := \
 	$(wear_leveling_common_SRC) \
 	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_8byte.cpp
 wear_leveling_8byte_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_benchmark_2byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=16384 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=1024 \
+	-DWEAR_LEVELING_BENCHMARK_INIT_REPEAT=20 \
+	-DWEAR_LEVELING_BENCHMARK_WRITES=20000
+wear_leveling_benchmark_2byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_benchmark.cpp
+wear_leveling_benchmark_2byte_INC := \
+	$(wear_leveling_common_INC) \
+	tests/test_common
+
+wear_leveling_benchmark_4byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=4 \
+	-DWEAR_LEVELING_BACKING_SIZE=16384 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=1024 \
+	-DWEAR_LEVELING_BENCHMARK_INIT_REPEAT=20 \
+	-DWEAR_LEVELING_BENCHMARK_WRITES=20000
+wear_leveling_benchmark_4byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_benchmark.cpp
+wear_leveling_benchmark_4byte_INC := \
+	$(wear_leveling_common_INC) \
+	tests/test_common
+
+wear_leveling_benchmark_8byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=8 \
+	-DWEAR_LEVELING_BACKING_SIZE=16384 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=1024 \
+	-DWEAR_LEVELING_BENCHMARK_INIT_REPEAT=20 \
+	-DWEAR_LEVELING_BENCHMARK_WRITES=20000
+wear_leveling_benchmark_8byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_benchmark.cpp
+wear_leveling_benchmark_8byte_INC := \
+	$(wear_leveling_common_INC) \
+	tests/test_common
+
+wear_leveling_fuzz_2byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=2048 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=256 \
+	-DWEAR_LEVELING_FUZZ_TRIALS=2000
+wear_leveling_fuzz_2byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_fuzz.cpp
+wear_leveling_fuzz_2byte_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_fuzz_4byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=4 \
+	-DWEAR_LEVELING_BACKING_SIZE=2048 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=256 \
+	-DWEAR_LEVELING_FUZZ_TRIALS=2000
+wear_leveling_fuzz_4byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_fuzz.cpp
+wear_leveling_fuzz_4byte_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_fuzz_8byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=8 \
+	-DWEAR_LEVELING_BACKING_SIZE=2048 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=256 \
+	-DWEAR_LEVELING_FUZZ_TRIALS=2000
+wear_leveling_fuzz_8byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_fuzz.cpp
+wear_leveling_fuzz_8byte_INC := \
 	$(wear_leveling_common_INC)
\ No newline at end of file
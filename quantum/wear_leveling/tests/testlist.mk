@@ -3,4 +3,12 @@ TEST_LIST += \
 	wear_leveling_2byte_optimized_writes \
 	wear_leveling_2byte \
 	wear_leveling_4byte \
-	wear_leveling_8byte
+	wear_leveling_8byte \
+	wear_leveling_fuzz_2byte \
+	wear_leveling_fuzz_4byte \
+	wear_leveling_fuzz_8byte
+
+BENCHMARK_LIST += \
+	wear_leveling_benchmark_2byte \
+	wear_leveling_benchmark_4byte \
+	wear_leveling_benchmark_8byte
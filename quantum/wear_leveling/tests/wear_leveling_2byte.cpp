@@ -161,6 +161,92 @@ TEST_F(WearLeveling2Byte, PlaybackReadbackMultibyte_OOB) {
     EXPECT_EQ(buf[1], 0x12) << "Readback should have maintained the previous pre-failure value from the write log";
 }
 
+/**
+ * This test verifies multibyte readback gets canceled when a power loss tore the entry before its address was written.
+ */
+TEST_F(WearLeveling2Byte, PlaybackReadbackMultibyte_Torn) {
+    auto& inst     = MockBackingStore::Instance();
+    auto  logstart = inst.storage_begin() + (WEAR_LEVELING_LOGICAL_SIZE / sizeof(backing_store_int_t));
+
+    // Invalid FNV1a_64 hash
+    (logstart + 0)->set(0);
+    (logstart + 1)->set(0);
+    (logstart + 2)->set(0);
+    (logstart + 3)->set(0);
+
+    // Set up a 2-byte logical write of [0x11,0x12] at logical offset 0x01
+    auto entry0    = LOG_ENTRY_MAKE_MULTIBYTE(0x01, 2);
+    entry0.raw8[3] = 0x11;
+    entry0.raw8[4] = 0x12;
+    (logstart + 4)->set(~entry0.raw16[0]);
+    (logstart + 5)->set(~entry0.raw16[1]);
+    (logstart + 6)->set(~entry0.raw16[2]);
+
+    // Set up a 2-byte logical write of [0x13,0x14] at logical offset 0x0A, with the power lost after the first write
+    auto entry1 = LOG_ENTRY_MAKE_MULTIBYTE(0x0A, 2);
+    (logstart + 7)->set(~entry1.raw16[0]);
+
+    EXPECT_EQ(inst.erasure_count(), 0) << "Invalid initial erase count";
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_CONSOLIDATED) << "Readback should have failed and triggered consolidation";
+    EXPECT_EQ(inst.erasure_count(), 1) << "Invalid final erase count";
+
+    uint8_t buf[WEAR_LEVELING_LOGICAL_SIZE];
+    wear_leveling_read(0, buf, sizeof(buf));
+    EXPECT_EQ(buf[0x01], 0x11) << "Readback should have maintained the previous pre-failure value from the write log";
+    EXPECT_EQ(buf[0x02], 0x12) << "Readback should have maintained the previous pre-failure value from the write log";
+    for (std::size_t i = 0x03; i < sizeof(buf); ++i) {
+        EXPECT_EQ(buf[i], 0) << "Torn log entry should not have been played back";
+    }
+}
+
+/**
+ * This test verifies that a complete multibyte entry with an empty second write, as written by older firmware for a
+ * zero low address byte and a zero first value, is played back along with the entries after it.
+ */
+TEST_F(WearLeveling2Byte, PlaybackReadbackMultibyte_EmptySecondWrite) {
+    auto& inst     = MockBackingStore::Instance();
+    auto  logstart = inst.storage_begin() + (WEAR_LEVELING_LOGICAL_SIZE / sizeof(backing_store_int_t));
+
+    // Invalid FNV1a_64 hash
+    (logstart + 0)->set(0);
+    (logstart + 1)->set(0);
+    (logstart + 2)->set(0);
+    (logstart + 3)->set(0);
+
+    // Set up 1-byte logical writes of 0x11 at logical offset 0x00 and 0x12 at logical offset 0x01
+    auto entry0 = LOG_ENTRY_MAKE_OPTIMIZED_64(0x00, 0x11);
+    (logstart + 4)->set(~entry0.raw16[0]);
+    auto entry1 = LOG_ENTRY_MAKE_OPTIMIZED_64(0x01, 0x12);
+    (logstart + 5)->set(~entry1.raw16[0]);
+
+    // Set up a 2-byte logical write of [0x00,0x00] at logical offset 0x00, both of its trailing writes are empty
+    auto entry2 = LOG_ENTRY_MAKE_MULTIBYTE(0x00, 2);
+    ASSERT_EQ(entry2.raw16[1], 0) << "Second write of the entry should be empty";
+    ASSERT_EQ(entry2.raw16[2], 0) << "Third write of the entry should be empty";
+    (logstart + 6)->set(~entry2.raw16[0]);
+    (logstart + 7)->set(~entry2.raw16[1]);
+    (logstart + 8)->set(~entry2.raw16[2]);
+
+    // Set up a 2-byte logical write of [0x13,0x14] at logical offset 0x04
+    auto entry3    = LOG_ENTRY_MAKE_MULTIBYTE(0x04, 2);
+    entry3.raw8[3] = 0x13;
+    entry3.raw8[4] = 0x14;
+    (logstart + 9)->set(~entry3.raw16[0]);
+    (logstart + 10)->set(~entry3.raw16[1]);
+    (logstart + 11)->set(~entry3.raw16[2]);
+
+    EXPECT_EQ(inst.erasure_count(), 0) << "Invalid initial erase count";
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Readback should have succeeded";
+    EXPECT_EQ(inst.erasure_count(), 0) << "Invalid final erase count";
+
+    uint8_t buf[WEAR_LEVELING_LOGICAL_SIZE];
+    wear_leveling_read(0, buf, sizeof(buf));
+    EXPECT_EQ(buf[0x00], 0x00) << "Entry with an empty second write should have been played back";
+    EXPECT_EQ(buf[0x01], 0x00) << "Entry with an empty second write should have been played back";
+    EXPECT_EQ(buf[0x04], 0x13) << "Entry after the one with an empty second write should have been played back";
+    EXPECT_EQ(buf[0x05], 0x14) << "Entry after the one with an empty second write should have been played back";
+}
+
 /**
  * This test verifies optimized 64 readback gets canceled with an out-of-bounds address.
  */
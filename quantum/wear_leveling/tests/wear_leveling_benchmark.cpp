@@ -0,0 +1,129 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <string>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+#include "benchmark.hpp"
+#include "wear_leveling_workload.hpp"
+
+/**
+ * Host benchmark of the wear-leveling algorithm against the mocked backing store.
+ *
+ * CPU times are host wall clock times and only comparable between runs on the same machine. Backing store operation
+ * counts and the write amplification are exact and can be compared across machines.
+ */
+class WearLevelingBenchmark : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+        shadow.fill(0);
+    }
+
+    wear_leveling_status_t write(const WearLevelingWrite& w) {
+        std::copy(w.data.begin(), w.data.end(), shadow.begin() + w.address);
+        return wear_leveling_write(w.address, w.data.data(), w.data.size());
+    }
+
+    void verify_readback() {
+        EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+        std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> readback;
+        EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+        EXPECT_EQ(readback, shadow) << "Invalid readback";
+    }
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> shadow;
+};
+
+namespace {
+
+using benchmark::field;
+using benchmark::mean;
+using benchmark::percentile;
+
+const char* workload_name(WearLevelingWorkload workload) {
+    switch (workload) {
+        case WearLevelingWorkload::eeconfig:
+            return "eeconfig";
+        case WearLevelingWorkload::via_keymap:
+            return "via keymap";
+        case WearLevelingWorkload::via_bulk:
+            return "via bulk";
+        case WearLevelingWorkload::mixed:
+        default:
+            return "mixed";
+    }
+}
+
+} // namespace
+
+/**
+ * Measures how long wear_leveling_init() takes as the write log fills up, as that is what determines boot time.
+ */
+TEST_F(WearLevelingBenchmark, InitTimeByLogFill) {
+    auto&                         inst = MockBackingStore::Instance();
+    WearLevelingWorkloadGenerator generator(WearLevelingWorkload::via_keymap);
+
+    for (unsigned fill : {0, 25, 50, 75, 95}) {
+        while (wear_leveling_log_length(inst) * 100 < wear_leveling_log_capacity() * fill) {
+            EXPECT_NE(write(generator.next()), WEAR_LEVELING_FAILED) << "Write returned incorrect status";
+        }
+        std::size_t entries = wear_leveling_log_length(inst);
+
+        std::vector<std::uint64_t> init_ns;
+        for (int i = 0; i < WEAR_LEVELING_BENCHMARK_INIT_REPEAT; ++i) {
+            init_ns.push_back(benchmark::time_ns([]() { EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Init returned incorrect status"; }));
+        }
+
+        // clang-format off
+        benchmark::Line() << BACKING_STORE_WRITE_SIZE << "-byte init   log fill: " << field(fill, 3) << "%"
+                          << " | log entries: " << field(entries, 6) << " / " << wear_leveling_log_capacity()
+                          << " | init mean/max: " << field(mean(init_ns), 10) << " / " << field(percentile(init_ns, 100), 8) << " ns";
+        // clang-format on
+    }
+
+    verify_readback();
+}
+
+/**
+ * Measures write stalls and the write amplification for typical EEPROM traffic. Stalls are dominated by consolidation,
+ * which erases the backing store and rewrites the whole logical area.
+ */
+TEST_F(WearLevelingBenchmark, WriteStallsAndAmplification) {
+    auto& inst = MockBackingStore::Instance();
+
+    for (auto workload : {WearLevelingWorkload::eeconfig, WearLevelingWorkload::via_keymap, WearLevelingWorkload::via_bulk, WearLevelingWorkload::mixed}) {
+        inst.reset_instance();
+        wear_leveling_init();
+        shadow.fill(0);
+
+        WearLevelingWorkloadGenerator generator(workload);
+        std::vector<std::uint64_t>    write_ns;
+        std::vector<std::uint64_t>    backing_writes;
+        std::uint64_t                 changed_bytes = 0;
+
+        for (int i = 0; i < WEAR_LEVELING_BENCHMARK_WRITES; ++i) {
+            WearLevelingWrite w = generator.next();
+            for (std::size_t j = 0; j < w.data.size(); ++j) {
+                changed_bytes += shadow[w.address + j] != w.data[j];
+            }
+
+            std::uint64_t writes_before = inst.total_write_count();
+            write_ns.push_back(benchmark::time_ns([&]() { EXPECT_NE(write(w), WEAR_LEVELING_FAILED) << "Write returned incorrect status"; }));
+            backing_writes.push_back(inst.total_write_count() - writes_before);
+        }
+
+        double amplification = changed_bytes ? (double)(inst.total_write_count() * BACKING_STORE_WRITE_SIZE) / changed_bytes : 0.0;
+
+        // clang-format off
+        benchmark::Line() << BACKING_STORE_WRITE_SIZE << "-byte " << benchmark::label(workload_name(workload), 10)
+                          << " | write p50/p99/max: " << field(percentile(write_ns, 50), 6) << " / " << field(percentile(write_ns, 99), 6) << " / " << field(percentile(write_ns, 100), 8) << " ns"
+                          << " | backing writes p50/p99/max: " << field(percentile(backing_writes, 50), 2) << " / " << field(percentile(backing_writes, 99), 3) << " / " << field(percentile(backing_writes, 100), 5)
+                          << " | erases: " << field(inst.erasure_count(), 4)
+                          << " | write amplification: " << field(amplification, 0, 2);
+        // clang-format on
+
+        verify_readback();
+    }
+}
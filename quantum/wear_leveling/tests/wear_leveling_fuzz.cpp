@@ -0,0 +1,238 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <cstdlib>
+#include <iostream>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+#include "wear_leveling_workload.hpp"
+
+/**
+ * Randomised power-loss fuzzer.
+ *
+ * Runs a mixed workload against a small backing store so that consolidation happens often, and cuts the power after a
+ * random number of backing store operations. From that point on every write fails, just like a real power loss part way
+ * through an operation. Erases are treated as atomic, as the algorithm relies on the whole backing store being erased
+ * before the consolidated data is rewritten. The keyboard is then "rebooted" by re-initialising, and the recovered data
+ * is checked against what was written before the power loss.
+ *
+ * The seed and the number of power losses can be changed with WEAR_LEVELING_FUZZ_SEED and WEAR_LEVELING_FUZZ_TRIALS in
+ * the environment, for longer runs when changing the algorithm.
+ */
+class WearLevelingFuzz : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+        expected.fill(0);
+    }
+
+    void TearDown() override {
+        MockBackingStore::Instance().reset_instance();
+    }
+
+    /**
+     * Cuts the power after `operations` more backing store writes.
+     */
+    void arm_power_loss(std::uint64_t operations) {
+        auto& inst     = MockBackingStore::Instance();
+        remaining      = operations;
+        power_lost     = false;
+        auto power_cut = [this]() {
+            if (power_lost || remaining == 0) {
+                power_lost = true;
+                return false;
+            }
+            --remaining;
+            return true;
+        };
+        inst.set_write_callback([power_cut](std::uint64_t, std::uint32_t) mutable { return power_cut(); });
+        inst.set_erase_callback([this](std::uint64_t) {
+            power_lost |= remaining == 0;
+            return !power_lost;
+        });
+    }
+
+    /**
+     * Cuts the power `operations` backing store writes after the next erase, i.e. part way through consolidation.
+     */
+    void arm_power_loss_after_erase(std::uint64_t operations) {
+        auto& inst = MockBackingStore::Instance();
+        remaining  = operations;
+        power_lost = false;
+        erased     = false;
+        inst.set_write_callback([this](std::uint64_t, std::uint32_t) {
+            if (power_lost || (erased && remaining == 0)) {
+                power_lost = true;
+                return false;
+            }
+            remaining -= erased ? 1 : 0;
+            return true;
+        });
+        inst.set_erase_callback([this](std::uint64_t) {
+            erased = true;
+            return true;
+        });
+    }
+
+    void restore_power() {
+        auto& inst = MockBackingStore::Instance();
+        inst.set_write_callback([](std::uint64_t, std::uint32_t) { return true; });
+        inst.set_erase_callback([](std::uint64_t) { return true; });
+    }
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> read_all() {
+        std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> data;
+        EXPECT_EQ(wear_leveling_read(0, data.data(), data.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+        return data;
+    }
+
+    /**
+     * Checks the recovered data against what was written before the power loss. Only the bytes of the interrupted write
+     * may differ, and those have to hold either the old or the new value.
+     */
+    bool check_recovered(const std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE>& recovered, const WearLevelingWrite& interrupted, std::uint32_t trial) {
+        bool consistent = true;
+        for (std::size_t i = 0; i < recovered.size(); ++i) {
+            bool in_range = i >= interrupted.address && i < interrupted.address + interrupted.data.size();
+            if (recovered[i] != expected[i] && !(in_range && recovered[i] == interrupted.data[i - interrupted.address])) {
+                consistent = false;
+                // A torn log entry keeps its address, so only the bytes of the interrupted write may change
+                EXPECT_TRUE(in_range) << "Power loss corrupted data outside the interrupted write at 0x" << std::hex << i << ", trial " << std::dec << trial;
+            }
+        }
+        return consistent;
+    }
+
+    static bool is_cleared(const std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE>& data) {
+        return std::all_of(data.begin(), data.end(), [](std::uint8_t b) { return b == 0; });
+    }
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> expected;
+    std::uint64_t                                        remaining  = 0;
+    bool                                                 power_lost = false;
+    bool                                                 erased     = false;
+};
+
+namespace {
+
+std::uint32_t env_or_default(const char* name, std::uint32_t value) {
+    const char* env = std::getenv(name);
+    return env ? (std::uint32_t)std::strtoul(env, nullptr, 0) : value;
+}
+
+} // namespace
+
+TEST_F(WearLevelingFuzz, RandomPowerLoss) {
+    auto&         inst   = MockBackingStore::Instance();
+    std::uint32_t seed   = env_or_default("WEAR_LEVELING_FUZZ_SEED", 0x2545F491);
+    std::uint32_t trials = env_or_default("WEAR_LEVELING_FUZZ_TRIALS", WEAR_LEVELING_FUZZ_TRIALS);
+    SCOPED_TRACE("WEAR_LEVELING_FUZZ_SEED=" + std::to_string(seed));
+
+    WearLevelingWorkloadGenerator generator(WearLevelingWorkload::mixed, seed);
+
+    std::uint32_t intact = 0, torn = 0, consolidating = 0;
+    for (std::uint32_t trial = 0; trial < trials && !HasFailure(); ++trial) {
+        // Regular use, every write has to make it
+        for (std::uint32_t i = generator.random(0, 200); i > 0; --i) {
+            WearLevelingWrite w = generator.next();
+            EXPECT_NE(wear_leveling_write(w.address, w.data.data(), w.data.size()), WEAR_LEVELING_FAILED) << "Write returned incorrect status";
+            std::copy(w.data.begin(), w.data.end(), expected.begin() + w.address);
+        }
+
+        // Keep writing until the power is cut part way through one of the writes
+        arm_power_loss(generator.random(0, 2 * BACKING_STORE_ELEMENT_COUNT::value));
+        WearLevelingWrite interrupted{0, {}};
+        std::uint64_t     erases_before = 0;
+        while (!power_lost) {
+            interrupted   = generator.next();
+            erases_before = inst.erase_invoke_count();
+            wear_leveling_write(interrupted.address, interrupted.data.data(), interrupted.data.size());
+            if (!power_lost) {
+                std::copy(interrupted.data.begin(), interrupted.data.end(), expected.begin() + interrupted.address);
+            }
+        }
+
+        // Reboot
+        restore_power();
+        ASSERT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Init after power loss failed, trial " << trial;
+        auto recovered = read_all();
+
+        if (inst.erase_invoke_count() != erases_before) {
+            // Power was cut during consolidation. Until the checksum is written the consolidated data is discarded on
+            // init, otherwise only the interrupted write may be torn.
+            if (!is_cleared(recovered)) {
+                check_recovered(recovered, interrupted, trial);
+            }
+            ++consolidating;
+        } else {
+            bool consistent = check_recovered(recovered, interrupted, trial);
+#if BACKING_STORE_WRITE_SIZE == 8
+            // Every log entry is a single backing store write, so writes are all-or-nothing per entry
+            EXPECT_TRUE(consistent) << "Power loss corrupted data outside of consolidation, trial " << trial;
+#endif
+            consistent ? ++intact : ++torn;
+        }
+
+        // Whatever survived has to stay readable and writable from here on
+        expected = recovered;
+    }
+
+    // Final round trip of everything written since the last power loss
+    ASSERT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Init failed";
+    EXPECT_EQ(read_all(), expected) << "Invalid readback";
+
+    // clang-format off
+    std::cout << "[ FUZZ     ] " << BACKING_STORE_WRITE_SIZE << "-byte power losses: " << trials
+              << " | intact: " << intact << " | torn log entry: " << torn << " | during consolidation: " << consolidating
+              << " | erases: " << inst.erasure_count()
+              << std::endl;
+    // clang-format on
+}
+
+TEST_F(WearLevelingFuzz, PowerLossDuringConsolidation) {
+    auto& inst = MockBackingStore::Instance();
+
+    // Consolidation writes the whole logical area followed by the FNV1a_64 checksum
+    constexpr std::uint64_t consolidation_writes = (WEAR_LEVELING_LOGICAL_SIZE + 8) / BACKING_STORE_WRITE_SIZE;
+
+    for (std::uint64_t cut = 0; cut <= consolidation_writes && !HasFailure(); ++cut) {
+        SCOPED_TRACE("power cut " + std::to_string(cut) + " writes after the erase");
+        inst.reset_instance();
+        ASSERT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Init failed";
+        expected.fill(0);
+
+        // Fill the write log until it consolidates, the power is cut part way through
+        WearLevelingWorkloadGenerator generator(WearLevelingWorkload::mixed, 0x2545F491 + (std::uint32_t)cut);
+        arm_power_loss_after_erase(cut);
+        WearLevelingWrite interrupted{0, {}};
+        while (!power_lost) {
+            interrupted = generator.next();
+            wear_leveling_write(interrupted.address, interrupted.data.data(), interrupted.data.size());
+            if (!power_lost) {
+                std::copy(interrupted.data.begin(), interrupted.data.end(), expected.begin() + interrupted.address);
+            }
+        }
+        ASSERT_EQ(inst.erase_invoke_count(), 1) << "Power was not cut during consolidation";
+
+        // Reboot
+        restore_power();
+        ASSERT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Init after power loss failed";
+        auto recovered = read_all();
+
+        if (cut < consolidation_writes) {
+            // The checksum didn't make it, so the torn consolidated data must not be used
+            EXPECT_TRUE(is_cleared(recovered)) << "Torn consolidated data was used after power loss";
+        } else {
+            // The consolidated data made it, only the write after it may be lost
+            EXPECT_TRUE(check_recovered(recovered, interrupted, (std::uint32_t)cut)) << "Consolidated data was lost after power loss";
+        }
+
+        // Whatever survived has to stay readable and writable from here on
+        WearLevelingWrite w = generator.next();
+        EXPECT_NE(wear_leveling_write(w.address, w.data.data(), w.data.size()), WEAR_LEVELING_FAILED) << "Write after power loss failed";
+        std::copy(w.data.begin(), w.data.end(), recovered.begin() + w.address);
+        ASSERT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Init failed";
+        EXPECT_EQ(read_all(), recovered) << "Invalid readback after power loss";
+    }
+}
@@ -0,0 +1,128 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+extern "C" {
+#include "wear_leveling_internal.h"
+};
+
+/**
+ * Kinds of EEPROM traffic seen on real keyboards.
+ */
+enum class WearLevelingWorkload {
+    eeconfig,   //< Small config fields near the start of EEPROM, mostly toggles and small values
+    via_keymap, //< Single keycode changes, written a byte at a time like eeprom_update_byte() does
+    via_bulk,   //< Host bulk loads of the keymap in 28 byte chunks
+    mixed,      //< A mix of the above, weighted towards config changes
+};
+
+struct WearLevelingWrite {
+    std::uint32_t             address;
+    std::vector<std::uint8_t> data;
+};
+
+/**
+ * Generates a deterministic stream of logical writes for a given workload.
+ */
+class WearLevelingWorkloadGenerator {
+   public:
+    // The dynamic keymap area starts after eeconfig and the VIA config.
+    static constexpr std::uint32_t keymap_start = 64;
+    static constexpr std::uint32_t bulk_size    = 28;
+
+    explicit WearLevelingWorkloadGenerator(WearLevelingWorkload workload, std::uint32_t seed = 0x2545F491) : m_workload(workload), m_seed(seed ? seed : 1) {}
+
+    WearLevelingWrite next() {
+        if (!m_pending.data.empty()) {
+            WearLevelingWrite w = m_pending;
+            m_pending.data.clear();
+            return w;
+        }
+
+        switch (m_workload) {
+            case WearLevelingWorkload::eeconfig:
+                return eeconfig();
+            case WearLevelingWorkload::via_keymap:
+                return via_keymap();
+            case WearLevelingWorkload::via_bulk:
+                return via_bulk();
+            case WearLevelingWorkload::mixed:
+            default: {
+                std::uint32_t r = random(0, 99);
+                return r < 60 ? eeconfig() : r < 90 ? via_keymap() : via_bulk();
+            }
+        }
+    }
+
+    std::uint32_t random(std::uint32_t min, std::uint32_t max) {
+        /* xorshift32, a fixed seed keeps runs identical. */
+        m_seed ^= m_seed << 13;
+        m_seed ^= m_seed >> 17;
+        m_seed ^= m_seed << 5;
+        return min + m_seed % (max - min + 1);
+    }
+
+   private:
+    WearLevelingWrite eeconfig() {
+        // Roughly the eeconfig layout: magic, debug, default layer, keymap, backlight, audio, rgblight, unicode, steno, haptic, rgb matrix and kb/user dwords.
+        static const struct {
+            std::uint8_t address;
+            std::uint8_t length;
+        } fields[] = {{0, 2}, {2, 1}, {3, 1}, {4, 2}, {6, 1}, {7, 1}, {8, 4}, {12, 1}, {13, 1}, {16, 4}, {20, 1}, {24, 8}, {32, 4}, {36, 4}};
+
+        const auto&       field = fields[random(0, sizeof(fields) / sizeof(fields[0]) - 1)];
+        WearLevelingWrite w{field.address, std::vector<std::uint8_t>(field.length)};
+        for (auto& b : w.data) {
+            std::uint32_t r = random(0, 3);
+            b               = r < 2 ? r : random(0, 255);
+        }
+        return w;
+    }
+
+    WearLevelingWrite via_keymap() {
+        std::uint32_t keys    = (WEAR_LEVELING_LOGICAL_SIZE - keymap_start) / 2;
+        std::uint32_t address = keymap_start + 2 * random(0, keys - 1);
+        std::uint16_t keycode = random(0, 3) ? random(0x04, 0xE7) : random(0x0100, 0x7FFF);
+
+        // Keycodes are stored big endian, one byte at a time.
+        m_pending = {address + 1, {(std::uint8_t)(keycode & 0xFF)}};
+        return {address, {(std::uint8_t)(keycode >> 8)}};
+    }
+
+    WearLevelingWrite via_bulk() {
+        std::uint32_t chunks  = (WEAR_LEVELING_LOGICAL_SIZE - keymap_start) / bulk_size;
+        std::uint32_t address = keymap_start + bulk_size * random(0, chunks - 1);
+
+        WearLevelingWrite w{address, std::vector<std::uint8_t>(bulk_size)};
+        for (std::size_t i = 0; i < w.data.size(); i += 2) {
+            w.data[i]     = random(0, 7) ? 0 : random(0x01, 0x7F);
+            w.data[i + 1] = random(0x04, 0xE7);
+        }
+        return w;
+    }
+
+    WearLevelingWorkload m_workload;
+    std::uint32_t        m_seed;
+    WearLevelingWrite    m_pending{0, {}};
+};
+
+/**
+ * Returns the number of backing store elements used by the write log.
+ */
+template <typename Store>
+std::size_t wear_leveling_log_length(const Store& store) {
+    const std::size_t log_start = (WEAR_LEVELING_LOGICAL_SIZE + 8) / sizeof(backing_store_int_t);
+    auto              begin     = store.storage_begin() + log_start;
+    auto              end       = std::find_if(begin, store.storage_end(), [](const auto& e) { return e.is_erased(); });
+    return end - begin;
+}
+
+/**
+ * Returns the number of backing store elements available to the write log.
+ */
+constexpr std::size_t wear_leveling_log_capacity() {
+    return (WEAR_LEVELING_BACKING_SIZE - WEAR_LEVELING_LOGICAL_SIZE - 8) / sizeof(backing_store_int_t);
+}
@@ -116,7 +116,12 @@
 
         For 2-byte backing store writes, the last two bytes are optional
             depending on the length of data to be written. Accordingly, either 3
-            or 4 backing store write operations will occur.
+            or 4 backing store write operations will occur. The second write is
+            never empty, so that an entry torn by a power loss can be detected:
+            if the low address byte and the first value are both zero, the entry
+            starts one byte earlier with the unchanged cached value. Older
+            firmware did write such entries, so an entry with an empty second
+            write is only taken as torn if nothing was written after it.
         For 4-byte backing store writes, either one or two write operations
             occur, depending on the length.
         For 8-byte backing store writes, one write operation occur.
@@ -453,6 +458,26 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
             p++;
             continue;
         }
+
+        // The second write of a multi-byte entry holds the low address byte and the first value. Playback takes it being
+        // empty for an entry torn by a power loss, so start the entry one byte earlier with the cached value instead.
+        if ((address & 0xFF) == 0 && *p == 0) {
+            uint8_t      shifted[LOG_ENTRY_MULTIBYTE_MAX_BYTES];
+            const size_t this_length = remaining >= LOG_ENTRY_MULTIBYTE_MAX_BYTES - 1 ? LOG_ENTRY_MULTIBYTE_MAX_BYTES - 1 : remaining;
+            shifted[0]               = wear_leveling.cache[address - 1];
+            memcpy(&shifted[1], p, this_length);
+            status = wear_leveling_write_raw_multibyte(address - 1, shifted, this_length + 1);
+            if (status != WEAR_LEVELING_SUCCESS) {
+                // If consolidation occurred, then the cache has already been written to the consolidated area. No need to continue.
+                // If a failure occurred, pass it on.
+                return status;
+            }
+
+            remaining -= this_length;
+            address += (uint32_t)this_length;
+            p += this_length;
+            continue;
+        }
 #endif // BACKING_STORE_WRITE_SIZE == 2
         const size_t this_length = remaining >= LOG_ENTRY_MULTIBYTE_MAX_BYTES ? LOG_ENTRY_MULTIBYTE_MAX_BYTES : remaining;
         status                   = wear_leveling_write_raw_multibyte(address, p, this_length);
@@ -469,6 +494,23 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
     return status;
 }
 
+#if BACKING_STORE_WRITE_SIZE == 2
+/**
+ * Checks whether the rest of a multibyte entry of the given length, and the slot after it, are still erased.
+ */
+static bool wear_leveling_log_erased(uint32_t address, uint8_t length) {
+    const uint8_t slots = 1 + (length > 1 ? 1 : 0) + (length > 3 ? 1 : 0);
+    for (uint8_t i = 0; i < slots && address < (WEAR_LEVELING_BACKING_SIZE); i++) {
+        backing_store_int_t value;
+        if (!backing_store_read(address, &value) || value != 0) {
+            return false;
+        }
+        address += (BACKING_STORE_WRITE_SIZE);
+    }
+    return true;
+}
+#endif // BACKING_STORE_WRITE_SIZE == 2
+
 /**
  * "Replays" the write log from the backing store, updating the local cache with updated values.
  */
@@ -508,8 +550,9 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 
         switch (LOG_ENTRY_GET_TYPE(log)) {
             case LOG_ENTRY_TYPE_MULTIBYTE: {
+                // A power loss during consolidation can leave a truncated entry in the last slots of the log, never read past the end.
 #if BACKING_STORE_WRITE_SIZE == 2
-                ok = backing_store_read(address, &log.raw16[1]);
+                ok = address < (WEAR_LEVELING_BACKING_SIZE) && backing_store_read(address, &log.raw16[1]);
                 if (!ok) {
                     wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                     cancel_playback = true;
@@ -517,6 +560,15 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                     break;
                 }
                 address += (BACKING_STORE_WRITE_SIZE);
+
+                // Written entries never have an empty second write, unless written by older firmware. Only the last entry of the
+                // log can have been torn by a power loss, so anything written after it means the entry is complete.
+                if (log.raw16[1] == 0 && wear_leveling_log_erased(address, LOG_ENTRY_MULTIBYTE_GET_LENGTH(log))) {
+                    wl_dprintf("Found torn log entry, skipping playback of write log\n");
+                    cancel_playback = true;
+                    status          = WEAR_LEVELING_FAILED;
+                    break;
+                }
 #endif // BACKING_STORE_WRITE_SIZE == 2
                 const uint32_t a = LOG_ENTRY_MULTIBYTE_GET_ADDRESS(log);
                 const uint8_t  l = LOG_ENTRY_MULTIBYTE_GET_LENGTH(log);
@@ -529,7 +581,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 
 #if BACKING_STORE_WRITE_SIZE == 2
                 if (l > 1) {
-                    ok = backing_store_read(address, &log.raw16[2]);
+                    ok = address < (WEAR_LEVELING_BACKING_SIZE) && backing_store_read(address, &log.raw16[2]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -539,7 +591,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                     address += (BACKING_STORE_WRITE_SIZE);
                 }
                 if (l > 3) {
-                    ok = backing_store_read(address, &log.raw16[3]);
+                    ok = address < (WEAR_LEVELING_BACKING_SIZE) && backing_store_read(address, &log.raw16[3]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -550,7 +602,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                 }
 #elif BACKING_STORE_WRITE_SIZE == 4
                 if (l > 1) {
-                    ok = backing_store_read(address, &log.raw32[1]);
+                    ok = address < (WEAR_LEVELING_BACKING_SIZE) && backing_store_read(address, &log.raw32[1]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -0,0 +1,61 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "quantum.h"
+#include "benchmark_keymap.h"
+
+// A combo table sized like a typical "10+ features" layout, so that the
+// per-event combo scan is representative of real boards.
+
+uint16_t const jk_combo[]  = {KC_J, KC_K, COMBO_END};
+uint16_t const df_combo[]  = {KC_D, KC_F, COMBO_END};
+uint16_t const sd_combo[]  = {KC_S, KC_D, COMBO_END};
+uint16_t const kl_combo[]  = {KC_K, KC_L, COMBO_END};
+uint16_t const we_combo[]  = {KC_W, KC_E, COMBO_END};
+uint16_t const io_combo[]  = {KC_I, KC_O, COMBO_END};
+uint16_t const xc_combo[]  = {KC_X, KC_C, COMBO_END};
+uint16_t const cv_combo[]  = {KC_C, KC_V, COMBO_END};
+uint16_t const mc_combo[]  = {KC_M, KC_COMM, COMBO_END};
+uint16_t const cd_combo[]  = {KC_COMM, KC_DOT, COMBO_END};
+uint16_t const qw_combo[]  = {KC_Q, KC_W, COMBO_END};
+uint16_t const op_combo[]  = {KC_O, KC_P, COMBO_END};
+uint16_t const sdf_combo[] = {KC_S, KC_D, KC_F, COMBO_END};
+uint16_t const jkl_combo[] = {KC_J, KC_K, KC_L, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    COMBO(jk_combo, KC_ESC),
+    COMBO(df_combo, KC_TAB),
+    COMBO(sd_combo, KC_LPRN),
+    COMBO(kl_combo, KC_RPRN),
+    COMBO(we_combo, KC_LBRC),
+    COMBO(io_combo, KC_RBRC),
+    COMBO(xc_combo, C(KC_C)),
+    COMBO(cv_combo, C(KC_V)),
+    COMBO(mc_combo, KC_MINS),
+    COMBO(cd_combo, KC_EQL),
+    COMBO(qw_combo, KC_GRV),
+    COMBO(op_combo, KC_BSLS),
+    COMBO(sdf_combo, KC_LCBR),
+    COMBO(jkl_combo, KC_RCBR),
+};
+// clang-format on
+
+tap_dance_action_t tap_dance_actions[] = {
+    [TD_SCLN_QUOT] = ACTION_TAP_DANCE_DOUBLE(KC_SCLN, KC_QUOT),
+    [TD_ESC_CAPS]  = ACTION_TAP_DANCE_DOUBLE(KC_ESC, KC_CAPS),
+};
+
+const key_override_t delete_key_override     = ko_make_basic(MOD_MASK_SHIFT, KC_BSPC, KC_DEL);
+const key_override_t next_track_override     = ko_make_basic(MOD_MASK_CTRL, KC_DOT, KC_MNXT);
+const key_override_t previous_track_override = ko_make_basic(MOD_MASK_CTRL, KC_COMM, KC_MPRV);
+const key_override_t enter_override          = ko_make_basic(MOD_MASK_SHIFT, KC_ENT, KC_ESC);
+
+// clang-format off
+const key_override_t **key_overrides = (const key_override_t *[]){
+    &delete_key_override,
+    &next_track_override,
+    &previous_track_override,
+    &enter_override,
+    NULL
+};
+// clang-format on
@@ -0,0 +1,17 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    TD_SCLN_QUOT,
+    TD_ESC_CAPS,
+};
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,12 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define TAPPING_TERM 200
+
+// Number of times the recorded trace is replayed per feature, larger values
+// give more stable numbers at the expense of test runtime.
+#define BENCHMARK_TRACE_REPEAT 20
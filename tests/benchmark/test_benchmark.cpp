@@ -0,0 +1,174 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+#include "trace_replay.hpp"
+#include "benchmark_keymap.h"
+
+using testing::_;
+
+namespace {
+const char *corpus = "the quick brown fox jumps over the lazy dog while five wizards box jack quickly and pack my box with dozens of liquor jugs ";
+} // namespace
+
+class Benchmark : public TestFixture {
+   protected:
+    // clang-format off
+    const std::string layout = "qwertyuiop"
+                               "asdfghjkl;"
+                               "zxcvbnm,./";
+    const uint16_t keycodes[30] = {
+        KC_Q, KC_W, KC_E, KC_R, KC_T, KC_Y, KC_U, KC_I,    KC_O,   KC_P,
+        KC_A, KC_S, KC_D, KC_F, KC_G, KC_H, KC_J, KC_K,    KC_L,   TD(TD_SCLN_QUOT),
+        KC_Z, KC_X, KC_C, KC_V, KC_B, KC_N, KC_M, KC_COMM, KC_DOT, KC_SLSH
+    };
+    // clang-format on
+
+    KeymapKey key_lsft{0, 0, 3, KC_LSFT};
+    KeymapKey key_bspc{0, 1, 3, KC_BSPC};
+    KeymapKey key_spc{0, 2, 3, KC_SPC};
+    KeymapKey key_ent{0, 3, 3, KC_ENT};
+    KeymapKey key_lctl{0, 4, 3, KC_LCTL};
+    KeymapKey key_esc_caps{0, 5, 3, TD(TD_ESC_CAPS)};
+    KeymapKey key_caps_word{0, 6, 3, CW_TOGG};
+
+    debug_config_t saved_debug_config;
+
+    void SetUp() override {
+        /* Console output would dominate the measurements. */
+        saved_debug_config = debug_config;
+        debug_config.raw   = 0;
+
+        keymap.clear();
+        for (uint8_t i = 0; i < layout.size(); i++) {
+            add_key(KeymapKey(0, i % MATRIX_COLS, i / MATRIX_COLS, keycodes[i]));
+        }
+        for (const KeymapKey &key : {key_lsft, key_bspc, key_spc, key_ent, key_lctl, key_esc_caps, key_caps_word}) {
+            add_key(key);
+        }
+
+        combo_disable();
+        key_override_off();
+        autoshift_disable();
+    }
+
+    void TearDown() override {
+        combo_enable();
+        key_override_on();
+        autoshift_enable();
+
+        debug_config = saved_debug_config;
+    }
+
+    KeymapKey key(char c) const {
+        if (c == ' ') {
+            return key_spc;
+        }
+        size_t i = layout.find(c);
+        return KeymapKey(0, i % MATRIX_COLS, i / MATRIX_COLS, keycodes[i]);
+    }
+
+    std::vector<KeymapKey> text(const std::string &s) const {
+        std::vector<KeymapKey> keys;
+        for (char c : s) {
+            keys.push_back(key(c));
+        }
+        return keys;
+    }
+
+    void run(const std::string &name, Trace &trace) {
+        TestDriver driver;
+
+        trace.idle(TAPPING_TERM * 5);
+        ReplayStats stats = replay_trace(trace, BENCHMARK_TRACE_REPEAT);
+        stats.print_summary(name);
+
+        EXPECT_GT(stats.presses, 0u);
+        EXPECT_EQ(stats.unreported, 0u);
+
+        /* The trace has to leave the keyboard in a clean state. */
+        EXPECT_NO_REPORT(driver);
+        idle_for(TAPPING_TERM * 2);
+        VERIFY_AND_CLEAR(driver);
+    }
+};
+
+TEST_F(Benchmark, Baseline) {
+    Trace trace;
+    trace.type(text(corpus)).type(text(corpus));
+    run("baseline", trace);
+}
+
+TEST_F(Benchmark, Combos) {
+    combo_enable();
+
+    Trace trace;
+    trace.type(text(corpus));
+    trace.chord({key('j'), key('k')}).chord({key('d'), key('f')}).chord({key('s'), key('d'), key('f')});
+    trace.type(text(corpus));
+    trace.chord({key('x'), key('c')}).chord({key(','), key('.')}).chord({key('j'), key('k'), key('l')});
+    run("combos", trace);
+}
+
+TEST_F(Benchmark, TapDance) {
+    Trace trace;
+    for (const char *word : {"quick ", "brown ", "fox ", "jumps "}) {
+        trace.type(text(word));
+        trace.tap(key(';')).idle(TAPPING_TERM);
+        trace.tap(key(';')).tap(key(';')).idle(TAPPING_TERM);
+        trace.tap(key_esc_caps).idle(TAPPING_TERM);
+    }
+    run("tap dance", trace);
+}
+
+TEST_F(Benchmark, KeyOverrides) {
+    key_override_on();
+
+    Trace trace;
+    for (const char *word : {"quick ", "brown ", "fox ", "jumps "}) {
+        trace.type(text(word));
+        trace.press(key_lsft).idle(30).tap(key_bspc).tap(key_bspc).release(key_lsft).idle(60);
+        trace.press(key_lctl).idle(30).tap(key('.')).tap(key(',')).release(key_lctl).idle(60);
+        trace.tap(key_ent);
+    }
+    run("key overrides", trace);
+}
+
+TEST_F(Benchmark, AutoShift) {
+    autoshift_enable();
+
+    Trace trace;
+    trace.type(text(corpus));
+    trace.tap(key('t'), AUTO_SHIFT_TIMEOUT + 20).tap(key('q'), AUTO_SHIFT_TIMEOUT + 20);
+    trace.type(text(corpus));
+    run("auto shift", trace);
+}
+
+TEST_F(Benchmark, CapsWord) {
+    Trace trace;
+    for (const char *word : {"quick ", "brown ", "fox ", "jumps ", "over ", "lazy ", "dog "}) {
+        trace.tap(key_caps_word);
+        trace.type(text(word));
+    }
+    run("caps word", trace);
+}
+
+TEST_F(Benchmark, AllFeatures) {
+    combo_enable();
+    key_override_on();
+    autoshift_enable();
+
+    Trace trace;
+    trace.type(text(corpus));
+    trace.chord({key('j'), key('k')}).tap(key(';')).tap(key_caps_word);
+    trace.type(text("quick brown "));
+    trace.press(key_lsft).idle(30).tap(key_bspc).release(key_lsft).idle(60);
+    trace.type(text(corpus));
+    run("all features", trace);
+}
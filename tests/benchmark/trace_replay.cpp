@@ -0,0 +1,193 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "trace_replay.hpp"
+#include <algorithm>
+#include "benchmark.hpp"
+
+extern "C" {
+#include "host.h"
+#include "keyboard.h"
+#include "test_matrix.h"
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+}
+
+namespace {
+
+struct ReplayContext {
+    ReplayStats*          stats;
+    std::vector<uint32_t> pending_presses;
+};
+
+ReplayContext* current_replay = nullptr;
+
+/* Every report that reaches the host completes all presses seen so far. */
+void complete_pending_presses(void) {
+    if (current_replay == nullptr) {
+        return;
+    }
+
+    uint32_t now = timer_read32();
+    for (uint32_t pressed_at : current_replay->pending_presses) {
+        current_replay->stats->latency_ms.push_back(now - pressed_at);
+    }
+    current_replay->pending_presses.clear();
+    current_replay->stats->reports++;
+}
+
+uint8_t capture_keyboard_leds(void) {
+    return 0;
+}
+
+void capture_send_keyboard(report_keyboard_t* report) {
+    complete_pending_presses();
+}
+
+void capture_send_nkro(report_nkro_t* report) {
+    complete_pending_presses();
+}
+
+void capture_send_mouse(report_mouse_t* report) {}
+
+void capture_send_extra(report_extra_t* report) {}
+
+host_driver_t capture_driver = {capture_keyboard_leds, capture_send_keyboard, capture_send_nkro, capture_send_mouse, capture_send_extra};
+
+} // namespace
+
+uint32_t Trace::next_random(uint32_t min, uint32_t max) {
+    /* xorshift32, a fixed seed keeps traces identical across runs. */
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 17;
+    m_seed ^= m_seed << 5;
+    return min + m_seed % (max - min + 1);
+}
+
+void Trace::add_event(uint32_t time, keypos_t position, bool pressed) {
+    /* Keep the events sorted by time, events at the same time stay in the
+     * order they were added. */
+    auto later = std::upper_bound(m_events.begin(), m_events.end(), time, [](uint32_t t, const TraceEvent& event) { return t < event.time; });
+    m_events.insert(later, {time, position, pressed});
+}
+
+Trace& Trace::press(const KeymapKey& key) {
+    add_event(m_cursor, key.position, true);
+    return *this;
+}
+
+Trace& Trace::release(const KeymapKey& key) {
+    add_event(m_cursor, key.position, false);
+    return *this;
+}
+
+Trace& Trace::idle(uint32_t ms) {
+    m_cursor += ms;
+    return *this;
+}
+
+Trace& Trace::tap(const KeymapKey& key, uint32_t hold_ms) {
+    press(key);
+    idle(hold_ms);
+    release(key);
+    return idle(next_random(40, 120));
+}
+
+Trace& Trace::chord(const std::vector<KeymapKey>& keys, uint32_t hold_ms) {
+    uint32_t start = m_cursor;
+    for (const KeymapKey& key : keys) {
+        press(key);
+        idle(next_random(2, 8));
+    }
+    /* A chord with many keys is released after its last press. */
+    m_cursor = std::max(m_cursor, start + hold_ms);
+    for (const KeymapKey& key : keys) {
+        release(key);
+    }
+    return idle(next_random(40, 120));
+}
+
+Trace& Trace::type(const std::vector<KeymapKey>& keys) {
+    uint32_t last_release = m_cursor;
+    keypos_t previous     = {.col = 0xFF, .row = 0xFF};
+
+    for (const KeymapKey& key : keys) {
+        /* A key can't be pressed again before it has been released. */
+        if (key.position.col == previous.col && key.position.row == previous.row && m_cursor <= last_release) {
+            m_cursor = last_release + next_random(10, 30);
+        }
+
+        uint32_t hold = next_random(50, 110);
+        add_event(m_cursor, key.position, true);
+        add_event(m_cursor + hold, key.position, false);
+
+        last_release = std::max(last_release, m_cursor + hold);
+        previous     = key.position;
+        m_cursor += next_random(70, 170);
+    }
+
+    m_cursor = std::max(m_cursor, last_release);
+    return *this;
+}
+
+ReplayStats replay_trace(const Trace& trace, unsigned repeat) {
+    ReplayStats   stats;
+    ReplayContext context{&stats, {}};
+
+    host_driver_t* previous_driver = host_get_driver();
+    host_set_driver(&capture_driver);
+    current_replay = &context;
+
+    const std::vector<TraceEvent>& events = trace.events();
+
+    for (unsigned i = 0; i < repeat; i++) {
+        size_t next_event = 0;
+
+        for (uint32_t t = 0; t <= trace.duration(); t++) {
+            bool event_scan = false;
+
+            while (next_event < events.size() && events[next_event].time == t) {
+                const TraceEvent& event = events[next_event++];
+                if (event.pressed) {
+                    press_key(event.position.col, event.position.row);
+                    context.pending_presses.push_back(timer_read32());
+                    stats.presses++;
+                } else {
+                    release_key(event.position.col, event.position.row);
+                }
+                stats.events++;
+                event_scan = true;
+            }
+
+            uint64_t scan_ns = benchmark::time_ns(keyboard_task);
+
+            stats.total_ns += scan_ns;
+            (event_scan ? stats.event_scan_ns : stats.idle_scan_ns).push_back(scan_ns);
+
+            advance_time(1);
+        }
+    }
+
+    stats.unreported = context.pending_presses.size();
+
+    current_replay = nullptr;
+    host_set_driver(previous_driver);
+
+    return stats;
+}
+
+void ReplayStats::print_summary(const std::string& name) {
+    using benchmark::field;
+    using benchmark::mean;
+    using benchmark::percentile;
+
+    // clang-format off
+    benchmark::Line() << benchmark::label(name, 14)
+                      << " events: " << field(events, 6)
+                      << " | cpu/event: " << field(events ? (double)total_ns / events : 0.0, 8) << " ns"
+                      << " | event scan mean/p99/max: " << field(mean(event_scan_ns), 8) << " / " << field(percentile(event_scan_ns, 99), 7) << " / " << field(percentile(event_scan_ns, 100), 7) << " ns"
+                      << " | idle scan mean: " << field(mean(idle_scan_ns), 6) << " ns"
+                      << " | latency mean/p99/max: " << field(mean(latency_ms), 5) << " / " << field(percentile(latency_ms, 99), 3) << " / " << field(percentile(latency_ms, 100), 3) << " ms";
+    // clang-format on
+}
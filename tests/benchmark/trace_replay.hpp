@@ -0,0 +1,94 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "test_keymap_key.hpp"
+
+/**
+ * @brief A single recorded matrix transition, `time` is in milliseconds
+ * relative to the start of the trace.
+ */
+struct TraceEvent {
+    uint32_t time;
+    keypos_t position;
+    bool     pressed;
+};
+
+/**
+ * @brief A recorded keystroke trace that can be replayed through the full
+ * keyboard_task() -> matrix_task() -> action_exec() -> process_record_quantum()
+ * pipeline.
+ *
+ * Typing is generated from a fixed seed, so every run replays exactly the same
+ * sequence of matrix transitions including key rollover.
+ */
+class Trace {
+   public:
+    /**
+     * @brief Types `keys` in order with human-like dwell and flight times.
+     * Consecutive keys may overlap, just like fast typing does.
+     */
+    Trace& type(const std::vector<KeymapKey>& keys);
+
+    /**
+     * @brief Taps `key`, holding it for `hold_ms`.
+     */
+    Trace& tap(const KeymapKey& key, uint32_t hold_ms = 60);
+
+    /**
+     * @brief Presses all `keys` within a few milliseconds of each other and
+     * releases them together after `hold_ms`.
+     */
+    Trace& chord(const std::vector<KeymapKey>& keys, uint32_t hold_ms = 80);
+
+    Trace& press(const KeymapKey& key);
+    Trace& release(const KeymapKey& key);
+    Trace& idle(uint32_t ms);
+
+    /** @brief The recorded events, sorted by time. */
+    const std::vector<TraceEvent>& events() const {
+        return m_events;
+    }
+
+    /** @brief Length of the trace in milliseconds. */
+    uint32_t duration() const {
+        return m_cursor;
+    }
+
+   private:
+    uint32_t next_random(uint32_t min, uint32_t max);
+    void     add_event(uint32_t time, keypos_t position, bool pressed);
+
+    std::vector<TraceEvent> m_events;
+    uint32_t                m_cursor = 0;
+    uint32_t                m_seed   = 0x2545F491;
+};
+
+/**
+ * @brief Results of replaying a trace. CPU time is host wall clock time spent
+ * inside keyboard_task(), latency is simulated time from a key press until the
+ * next report that reaches the host.
+ */
+struct ReplayStats {
+    uint32_t              events     = 0;
+    uint32_t              presses    = 0;
+    uint32_t              reports    = 0;
+    uint32_t              unreported = 0;
+    uint64_t              total_ns   = 0;
+    std::vector<uint64_t> event_scan_ns;
+    std::vector<uint64_t> idle_scan_ns;
+    std::vector<uint32_t> latency_ms;
+
+    void print_summary(const std::string& name);
+};
+
+/**
+ * @brief Replays `trace` `repeat` times against the keymap of the currently
+ * active TestFixture. Reports are captured by a lightweight host driver while
+ * the trace runs, so that gmock matching does not end up in the measurements.
+ */
+ReplayStats replay_trace(const Trace& trace, unsigned repeat);
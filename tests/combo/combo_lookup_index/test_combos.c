@@ -0,0 +1,19 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "quantum.h"
+
+enum combos { ab_esc, cb_tab, abc_enter, de_bspc };
+
+uint16_t const ab_combo[]  = {KC_A, KC_B, COMBO_END};
+uint16_t const cb_combo[]  = {KC_C, KC_B, COMBO_END};
+uint16_t const abc_combo[] = {KC_A, KC_B, KC_C, COMBO_END};
+uint16_t const de_combo[]  = {KC_D, KC_E, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    [ab_esc]    = COMBO(ab_combo, KC_ESC),
+    [cb_tab]    = COMBO(cb_combo, KC_TAB),
+    [abc_enter] = COMBO(abc_combo, KC_ENT),
+    [de_bspc]   = COMBO(de_combo, KC_BSPC),
+};
+// clang-format on
@@ -0,0 +1,188 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "deferred_exec.h"
+#include "timer.h"
+void advance_time(uint32_t ms);
+}
+
+class DeferredExec : public ::testing::Test {
+   protected:
+    struct Call {
+        int      id;
+        uint32_t trigger_time;
+        uint32_t time;
+    };
+
+    static std::vector<Call> calls;
+    static uint32_t          repeat_ms;
+
+    static uint32_t record(uint32_t trigger_time, void *cb_arg) {
+        calls.push_back({(int)(intptr_t)cb_arg, trigger_time, timer_read32()});
+        return repeat_ms;
+    }
+
+    void SetUp() override {
+        calls.clear();
+        repeat_ms = 0;
+    }
+
+    void TearDown() override {
+        for (deferred_token token : tokens) {
+            cancel_deferred_exec(token);
+        }
+        run_for(1000);
+    }
+
+    deferred_token defer(uint32_t delay_ms, int id) {
+        deferred_token token = defer_exec(delay_ms, record, (void *)(intptr_t)id);
+        tokens.push_back(token);
+        return token;
+    }
+
+    void run_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            advance_time(1);
+            deferred_exec_task();
+        }
+    }
+
+    std::vector<deferred_token> tokens;
+};
+
+std::vector<DeferredExec::Call> DeferredExec::calls;
+uint32_t                        DeferredExec::repeat_ms;
+
+TEST_F(DeferredExec, ExecutesAfterDelay) {
+    uint32_t start = timer_read32();
+    EXPECT_NE(defer(10, 1), INVALID_DEFERRED_TOKEN);
+
+    run_for(9);
+    EXPECT_TRUE(calls.empty());
+    run_for(1);
+    ASSERT_EQ(calls.size(), 1);
+    EXPECT_EQ(calls[0].id, 1);
+    EXPECT_EQ(calls[0].time, start + 10);
+}
+
+TEST_F(DeferredExec, RepeatsRelativeToTrigger) {
+    repeat_ms = 5;
+    uint32_t start = timer_read32();
+    defer(5, 1);
+
+    run_for(20);
+    ASSERT_EQ(calls.size(), 4);
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(calls[i].trigger_time, start + 5 * (i + 1));
+    }
+}
+
+TEST_F(DeferredExec, RejectsInvalidRequests) {
+    EXPECT_EQ(defer_exec(0, record, NULL), INVALID_DEFERRED_TOKEN);
+    EXPECT_EQ(defer_exec(10, NULL, NULL), INVALID_DEFERRED_TOKEN);
+    EXPECT_FALSE(cancel_deferred_exec(INVALID_DEFERRED_TOKEN));
+    EXPECT_FALSE(extend_deferred_exec(INVALID_DEFERRED_TOKEN, 10));
+}
+
+TEST_F(DeferredExec, TableCapacity) {
+    for (int i = 0; i < MAX_DEFERRED_EXECUTORS; i++) {
+        EXPECT_NE(defer(10, i), INVALID_DEFERRED_TOKEN);
+    }
+    EXPECT_EQ(defer(10, MAX_DEFERRED_EXECUTORS), INVALID_DEFERRED_TOKEN);
+
+    // Freed slots are reused
+    EXPECT_TRUE(cancel_deferred_exec(tokens[0]));
+    EXPECT_NE(defer(10, MAX_DEFERRED_EXECUTORS), INVALID_DEFERRED_TOKEN);
+}
+
+TEST_F(DeferredExec, CancelPreventsExecution) {
+    deferred_token token = defer(10, 1);
+    EXPECT_TRUE(cancel_deferred_exec(token));
+    EXPECT_FALSE(cancel_deferred_exec(token));
+
+    run_for(20);
+    EXPECT_TRUE(calls.empty());
+}
+
+TEST_F(DeferredExec, ExtendDelaysExecution) {
+    uint32_t       start = timer_read32();
+    deferred_token token = defer(10, 1);
+
+    run_for(5);
+    EXPECT_TRUE(extend_deferred_exec(token, 10));
+    run_for(10);
+    ASSERT_EQ(calls.size(), 1);
+    EXPECT_EQ(calls[0].time, start + 15);
+}
+
+TEST_F(DeferredExec, StaleTokenDoesNotAffectReusedSlot) {
+    deferred_token stale = defer(10, 1);
+    EXPECT_TRUE(cancel_deferred_exec(stale));
+
+    // The same slot is handed out again, with a different token
+    deferred_token fresh = defer(10, 2);
+    EXPECT_NE(fresh, INVALID_DEFERRED_TOKEN);
+    EXPECT_NE(fresh, stale);
+
+    EXPECT_FALSE(cancel_deferred_exec(stale));
+    EXPECT_FALSE(extend_deferred_exec(stale, 100));
+
+    run_for(10);
+    ASSERT_EQ(calls.size(), 1);
+    EXPECT_EQ(calls[0].id, 2);
+}
+
+TEST_F(DeferredExec, TokensAreNotExhausted) {
+    // Far more allocations than an 8-bit token space, none of them may collide with a live token
+    deferred_token held = defer(1000, 1);
+    for (int i = 0; i < 1000; i++) {
+        deferred_token token = defer_exec(10, record, NULL);
+        ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+        ASSERT_NE(token, held);
+        ASSERT_TRUE(cancel_deferred_exec(token));
+    }
+    EXPECT_TRUE(cancel_deferred_exec(held));
+}
+
+TEST_F(DeferredExec, ReportsNextTrigger) {
+    uint32_t trigger_time;
+    run_for(1);
+    EXPECT_FALSE(deferred_exec_next_trigger(&trigger_time));
+
+    uint32_t start = timer_read32();
+    defer(30, 1);
+    defer(10, 2);
+    defer(20, 3);
+    ASSERT_TRUE(deferred_exec_next_trigger(&trigger_time));
+    EXPECT_EQ(trigger_time, start + 10);
+
+    run_for(10);
+    ASSERT_TRUE(deferred_exec_next_trigger(&trigger_time));
+    EXPECT_EQ(trigger_time, start + 20);
+
+    run_for(20);
+    EXPECT_EQ(calls.size(), 3);
+    EXPECT_FALSE(deferred_exec_next_trigger(&trigger_time));
+}
+
+TEST_F(DeferredExec, CallbackCanRequeueItself) {
+    struct Chain {
+        static uint32_t next(uint32_t trigger_time, void *cb_arg) {
+            intptr_t count = (intptr_t)cb_arg;
+            record(trigger_time, cb_arg);
+            if (count < 3) {
+                EXPECT_NE(defer_exec(1, next, (void *)(count + 1)), INVALID_DEFERRED_TOKEN);
+            }
+            return 0;
+        }
+    };
+    EXPECT_NE(defer_exec(1, Chain::next, (void *)(intptr_t)1), INVALID_DEFERRED_TOKEN);
+
+    run_for(10);
+    ASSERT_EQ(calls.size(), 3);
+    EXPECT_EQ(calls[2].id, 3);
+}
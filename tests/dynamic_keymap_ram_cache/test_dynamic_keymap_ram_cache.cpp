@@ -0,0 +1,90 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "eeprom.h"
+}
+
+using testing::_;
+
+class DynamicKeymapRamCache : public TestFixture {
+   protected:
+    void TearDown() override {
+        dynamic_keymap_flush();
+        TestFixture::TearDown();
+    }
+
+    uint16_t stored_keycode(uint8_t layer, uint8_t row, uint8_t column) {
+        uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(layer, row, column);
+        return eeprom_read_byte(address) << 8 | eeprom_read_byte(address + 1);
+    }
+};
+
+TEST_F(DynamicKeymapRamCache, write_is_read_back_before_commit) {
+    uint16_t keycode = dynamic_keymap_get_keycode(1, 2, 3);
+    dynamic_keymap_set_keycode(1, 2, 3, KC_F13);
+
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 2, 3), KC_F13);
+    EXPECT_EQ(stored_keycode(1, 2, 3), keycode);
+}
+
+TEST_F(DynamicKeymapRamCache, writes_are_committed_after_timeout) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    dynamic_keymap_set_keycode(0, 0, 0, KC_F14);
+    idle_for(DYNAMIC_KEYMAP_FLUSH_TIMEOUT / 2);
+    dynamic_keymap_set_keycode(0, 0, 1, KC_F15);
+    idle_for(DYNAMIC_KEYMAP_FLUSH_TIMEOUT / 2 + 1);
+
+    /* The second write restarted the timeout. */
+    EXPECT_NE(stored_keycode(0, 0, 0), KC_F14);
+    EXPECT_NE(stored_keycode(0, 0, 1), KC_F15);
+
+    idle_for(DYNAMIC_KEYMAP_FLUSH_TIMEOUT);
+    EXPECT_EQ(stored_keycode(0, 0, 0), KC_F14);
+    EXPECT_EQ(stored_keycode(0, 0, 1), KC_F15);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicKeymapRamCache, buffer_writes_are_committed_on_flush) {
+    uint8_t data[28];
+    for (uint8_t i = 0; i < sizeof(data); i += 2) {
+        data[i]     = 0;
+        data[i + 1] = KC_A + i / 2;
+    }
+    uint16_t offset = (MATRIX_ROWS * MATRIX_COLS * 2) - 6;
+    dynamic_keymap_set_buffer(offset, sizeof(data), data);
+
+    uint8_t readback[sizeof(data)];
+    dynamic_keymap_get_buffer(offset, sizeof(readback), readback);
+    EXPECT_EQ(memcmp(readback, data, sizeof(data)), 0);
+
+    dynamic_keymap_flush();
+    for (uint8_t i = 0; i < sizeof(data); i += 2) {
+        uint16_t key = (offset + i) / 2;
+        EXPECT_EQ(stored_keycode(key / (MATRIX_ROWS * MATRIX_COLS), key / MATRIX_COLS % MATRIX_ROWS, key % MATRIX_COLS), KC_A + i / 2);
+    }
+}
+
+TEST_F(DynamicKeymapRamCache, macros_are_cached) {
+    uint8_t  macros[] = {'a', 0, 'b', 0};
+    uint16_t size     = dynamic_keymap_macro_get_buffer_size();
+    dynamic_keymap_macro_reset();
+    dynamic_keymap_macro_set_buffer(0, sizeof(macros), macros);
+
+    uint8_t readback[sizeof(macros)];
+    dynamic_keymap_macro_get_buffer(0, sizeof(readback), readback);
+    EXPECT_EQ(memcmp(readback, macros, sizeof(macros)), 0);
+
+    dynamic_keymap_flush();
+    uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(0, 0, 0) + dynamic_keymap_get_layer_count() * MATRIX_ROWS * MATRIX_COLS * 2;
+    EXPECT_EQ(eeprom_read_byte(address + 2), 'b');
+    EXPECT_EQ(eeprom_read_byte(address + size - 1), 0);
+}
@@ -0,0 +1,10 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define KEY_OVERRIDE_REPEAT_DELAY 500
+#define KEY_OVERRIDE_LOOKUP_INDEX
+#define KEY_OVERRIDE_LOOKUP_INDEX_LENGTH 128
@@ -0,0 +1,7 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+KEY_OVERRIDE_ENABLE = yes
+
+# Runs the key override tests against the lookup index
+SRC += tests/key_overrides/test_key_overrides.cpp
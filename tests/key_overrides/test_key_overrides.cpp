@@ -0,0 +1,304 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+/* Same as ko_make_with_layers_negmods_and_options(), whose designated
+ * initializers are not in declaration order and so do not compile as C++. */
+static key_override_t make_override(uint8_t trigger_mods, uint16_t trigger, uint16_t replacement, layer_state_t layers = ~0, uint8_t negative_mask = 0) {
+    key_override_t override    = {};
+    override.trigger           = trigger;
+    override.trigger_mods      = trigger_mods;
+    override.layers            = layers;
+    override.negative_mod_mask = negative_mask;
+    override.suppressed_mods   = trigger_mods;
+    override.replacement       = replacement;
+    override.options           = ko_options_default;
+    return override;
+}
+
+class KeyOverride : public TestFixture {
+   protected:
+    void TearDown() override {
+        key_overrides = NULL;
+        TestFixture::TearDown();
+    }
+
+    /* Points key_overrides to a NULL terminated copy of the overrides. Every
+     * copy is kept, so that each one is a different array with its own address,
+     * as the lookup index is only rebuilt when key_overrides changes. */
+    void set_overrides(const std::vector<key_override_t>& overrides) {
+        override_tables.emplace_back(overrides);
+        override_pointers.emplace_back();
+        for (const key_override_t& override : override_tables.back()) {
+            override_pointers.back().push_back(&override);
+        }
+        override_pointers.back().push_back(NULL);
+        key_overrides = override_pointers.back().data();
+    }
+
+    void press(KeymapKey& key) {
+        key.press();
+        run_one_scan_loop();
+    }
+
+    void release(KeymapKey& key) {
+        key.release();
+        run_one_scan_loop();
+    }
+
+    static std::deque<std::vector<key_override_t>>        override_tables;
+    static std::deque<std::vector<const key_override_t*>> override_pointers;
+};
+
+std::deque<std::vector<key_override_t>>        KeyOverride::override_tables;
+std::deque<std::vector<const key_override_t*>> KeyOverride::override_pointers;
+
+TEST_F(KeyOverride, shift_backspace_sends_delete) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_shift(0, 0, 0, KC_LSFT);
+    KeymapKey  key_bspc(0, 1, 0, KC_BSPC);
+    set_keymap({key_shift, key_bspc});
+    set_overrides({make_override(MOD_MASK_SHIFT, KC_BSPC, KC_DEL)});
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    press(key_shift);
+    EXPECT_REPORT(driver, (KC_DEL));
+    press(key_bspc);
+    EXPECT_REPORT(driver, (KC_LSFT));
+    release(key_bspc);
+    EXPECT_EMPTY_REPORT(driver);
+    release(key_shift);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, trigger_without_mods_passes_through) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_bspc(0, 1, 0, KC_BSPC);
+    set_keymap({key_bspc});
+    set_overrides({make_override(MOD_MASK_SHIFT, KC_BSPC, KC_DEL)});
+
+    EXPECT_REPORT(driver, (KC_BSPC));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_bspc);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, negative_mods_block_override) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_ctrl(0, 0, 0, KC_LCTL);
+    KeymapKey  key_shift(0, 1, 0, KC_LSFT);
+    KeymapKey  key_bspc(0, 2, 0, KC_BSPC);
+    set_keymap({key_ctrl, key_shift, key_bspc});
+    set_overrides({make_override(MOD_MASK_SHIFT, KC_BSPC, KC_DEL, ~0, MOD_MASK_CTRL)});
+
+    EXPECT_REPORT(driver, (KC_LCTL));
+    press(key_ctrl);
+    EXPECT_REPORT(driver, (KC_LCTL, KC_LSFT));
+    press(key_shift);
+    EXPECT_REPORT(driver, (KC_LCTL, KC_LSFT, KC_BSPC));
+    press(key_bspc);
+    EXPECT_REPORT(driver, (KC_LCTL, KC_LSFT));
+    release(key_bspc);
+    EXPECT_REPORT(driver, (KC_LSFT));
+    release(key_ctrl);
+    EXPECT_EMPTY_REPORT(driver);
+    release(key_shift);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, override_only_on_its_layers) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_shift(0, 0, 0, KC_LSFT);
+    KeymapKey  key_layer(0, 1, 0, MO(1));
+    KeymapKey  key_a(0, 2, 0, KC_A);
+    KeymapKey  key_b(1, 2, 0, KC_B);
+    set_keymap({key_shift, key_layer, key_a, key_b});
+    set_overrides({make_override(MOD_MASK_SHIFT, KC_B, KC_C, 1 << 1), make_override(MOD_MASK_SHIFT, KC_A, KC_D, 1 << 1)});
+
+    // Shifted A on layer 0 is not overridden
+    EXPECT_REPORT(driver, (KC_LSFT));
+    press(key_shift);
+    EXPECT_REPORT(driver, (KC_LSFT, KC_A));
+    press(key_a);
+    EXPECT_REPORT(driver, (KC_LSFT));
+    release(key_a);
+    VERIFY_AND_CLEAR(driver);
+
+    // Shifted B on layer 1 is
+    EXPECT_NO_REPORT(driver);
+    press(key_layer);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_REPORT(driver, (KC_C));
+    press(key_b);
+    EXPECT_REPORT(driver, (KC_LSFT));
+    release(key_b);
+    EXPECT_EMPTY_REPORT(driver);
+    release(key_shift);
+    release(key_layer);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, first_listed_override_wins) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_shift(0, 0, 0, KC_LSFT);
+    KeymapKey  key_a(0, 1, 0, KC_A);
+    set_keymap({key_shift, key_a});
+    set_overrides({make_override(MOD_MASK_CTRL, KC_A, KC_B), make_override(MOD_MASK_SHIFT, KC_A, KC_C), make_override(MOD_MASK_SHIFT, KC_NO, KC_E), make_override(MOD_MASK_SHIFT, KC_A, KC_D)});
+
+    // The trigger-less override activates on shift alone, and suppresses it
+    EXPECT_NO_REPORT(driver);
+    press(key_shift);
+    VERIFY_AND_CLEAR(driver);
+
+    // Until A is pressed, for which the override listed first takes over
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_REPORT(driver, (KC_C));
+    press(key_a);
+    EXPECT_REPORT(driver, (KC_LSFT));
+    release(key_a);
+    EXPECT_EMPTY_REPORT(driver);
+    release(key_shift);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, trigger_less_override_while_key_held) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_alt(0, 0, 0, KC_RALT);
+    KeymapKey  key_x(0, 1, 0, KC_X);
+    set_keymap({key_alt, key_x});
+    set_overrides({make_override(MOD_BIT(KC_RALT), KC_NO, KC_F24)});
+
+    EXPECT_REPORT(driver, (KC_X));
+    press(key_x);
+    VERIFY_AND_CLEAR(driver);
+
+    // Only right alt is needed, the held key is not its trigger
+    EXPECT_NO_REPORT(driver);
+    press(key_alt);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_X, KC_F24));
+    idle_for(KEY_OVERRIDE_REPEAT_DELAY);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_X, KC_RALT));
+    EXPECT_REPORT(driver, (KC_X));
+    release(key_alt);
+    EXPECT_EMPTY_REPORT(driver);
+    release(key_x);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, mod_pressed_after_trigger_is_deferred) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_shift(0, 0, 0, KC_LSFT);
+    KeymapKey  key_bspc(0, 1, 0, KC_BSPC);
+    set_keymap({key_shift, key_bspc});
+    set_overrides({make_override(MOD_MASK_SHIFT, KC_BSPC, KC_DEL)});
+
+    EXPECT_REPORT(driver, (KC_BSPC));
+    press(key_bspc);
+    EXPECT_EMPTY_REPORT(driver);
+    press(key_shift);
+    VERIFY_AND_CLEAR(driver);
+
+    // The replacement is registered once the key repeat delay has passed since the trigger was pressed
+    EXPECT_REPORT(driver, (KC_DEL));
+    idle_for(KEY_OVERRIDE_REPEAT_DELAY);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    release(key_bspc);
+    EXPECT_EMPTY_REPORT(driver);
+    release(key_shift);
+    VERIFY_AND_CLEAR(driver);
+}
+
+/* A symbol layer worth of overrides: three for each of 30 keys, one on shift
+ * which is blocked by ctrl, one on ctrl, and one on shift on another layer.
+ * Every key is pressed without mods, and with every combination of the mods. */
+TEST_F(KeyOverride, stress_many_overrides) {
+    TestDriver driver;
+    KeymapKey  key_shift(0, 0, 0, KC_LSFT);
+    KeymapKey  key_ctrl(0, 1, 0, KC_LCTL);
+    set_keymap({key_shift, key_ctrl});
+
+    std::vector<KeymapKey>      keys;
+    std::vector<key_override_t> overrides;
+    // Overrides no key event below can activate, interleaved with the others
+    overrides.push_back(make_override(MOD_MASK_ALT, KC_NO, KC_F24));
+    for (uint8_t i = 0; i < 30; i++) {
+        const uint16_t trigger = KC_A + i;
+        keys.push_back(KeymapKey(0, (i + 2) % MATRIX_COLS, (i + 2) / MATRIX_COLS, trigger));
+        add_key(keys.back());
+        overrides.push_back(make_override(MOD_MASK_SHIFT, trigger, KC_F1 + i % 12, ~0, MOD_MASK_CTRL));
+        overrides.push_back(make_override(MOD_MASK_CTRL, trigger, KC_F13 + i % 12));
+        overrides.push_back(make_override(MOD_MASK_SHIFT, trigger, KC_F24, 1 << 1));
+    }
+    set_overrides(overrides);
+    ASSERT_GT(overrides.size(), 60u);
+
+    for (uint8_t round = 0; round < 2; round++) {
+        for (uint8_t i = 0; i < keys.size(); i++) {
+            KeymapKey&     key     = keys[i];
+            const uint16_t shifted = KC_F1 + i % 12;
+            const uint16_t ctrled  = KC_F13 + i % 12;
+            InSequence     s;
+
+            EXPECT_REPORT(driver, (key.code));
+            EXPECT_EMPTY_REPORT(driver);
+            tap_key(key);
+
+            EXPECT_REPORT(driver, (KC_LSFT));
+            press(key_shift);
+            EXPECT_REPORT(driver, (shifted));
+            press(key);
+            EXPECT_REPORT(driver, (KC_LSFT));
+            release(key);
+            EXPECT_EMPTY_REPORT(driver);
+            release(key_shift);
+
+            EXPECT_REPORT(driver, (KC_LCTL));
+            press(key_ctrl);
+            EXPECT_REPORT(driver, (ctrled));
+            press(key);
+            EXPECT_REPORT(driver, (KC_LCTL));
+            release(key);
+
+            // The shifted override is blocked by ctrl
+            EXPECT_REPORT(driver, (KC_LCTL, KC_LSFT));
+            press(key_shift);
+            EXPECT_REPORT(driver, (KC_LSFT, ctrled));
+            press(key);
+            EXPECT_REPORT(driver, (KC_LCTL, KC_LSFT));
+            release(key);
+            EXPECT_REPORT(driver, (KC_LSFT));
+            release(key_ctrl);
+            EXPECT_EMPTY_REPORT(driver);
+            release(key_shift);
+            VERIFY_AND_CLEAR(driver);
+        }
+
+        // The same overrides in reverse order, from a different array
+        std::reverse(overrides.begin(), overrides.end());
+        set_overrides(overrides);
+    }
+}
@@ -0,0 +1,98 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+
+class LayerResolutionCache : public TestFixture {};
+
+TEST_F(LayerResolutionCache, transparent_key_resolves_to_lower_layer) {
+    TestDriver driver;
+    KeymapKey  key_mo(0, 0, 0, MO(1));
+    KeymapKey  key_a(0, 1, 0, KC_A);
+    set_keymap({key_mo, key_a, KeymapKey(1, 0, 0, KC_TRNS), KeymapKey(1, 1, 0, KC_TRNS)});
+
+    for (int i = 0; i < 3; i++) {
+        key_mo.press();
+        run_one_scan_loop();
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+        tap_key(key_a);
+        key_mo.release();
+        run_one_scan_loop();
+        VERIFY_AND_CLEAR(driver);
+
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+        tap_key(key_a);
+        VERIFY_AND_CLEAR(driver);
+    }
+}
+
+TEST_F(LayerResolutionCache, layer_state_changes_select_snapshot) {
+    KeymapKey key_a(0, 0, 0, KC_A);
+    KeymapKey key_b(1, 0, 0, KC_B);
+    KeymapKey key_c(2, 0, 0, KC_TRNS);
+    KeymapKey key_d(3, 0, 0, KC_D);
+    set_keymap({key_a, key_b, key_c, key_d});
+
+    /* More layer states than snapshot slots, visited repeatedly. */
+    for (int i = 0; i < 4; i++) {
+        layer_clear();
+        EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+        layer_on(1);
+        EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+        layer_on(2);
+        EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+        layer_on(3);
+        EXPECT_EQ(layer_switch_get_layer(key_a.position), 3);
+        layer_off(1);
+        EXPECT_EQ(layer_switch_get_layer(key_a.position), 3);
+        layer_off(3);
+        EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+    }
+}
+
+TEST_F(LayerResolutionCache, keymap_change_clears_cache) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    set_keymap({key_a, KeymapKey(1, 0, 0, KC_TRNS)});
+
+    layer_on(1);
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+
+    set_keymap({key_a, KeymapKey(1, 0, 0, KC_B)});
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerResolutionCache, invalidate_single_key) {
+    KeymapKey key_a(0, 0, 0, KC_A);
+    KeymapKey key_b(0, 1, 0, KC_B);
+    set_keymap({key_a, key_b, KeymapKey(1, 0, 0, KC_TRNS), KeymapKey(1, 1, 0, KC_TRNS)});
+
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+    EXPECT_EQ(layer_switch_get_layer(key_b.position), 0);
+
+    /* Both keys now resolve to layer 1, only key_a is told about it. */
+    keymap.clear();
+    for (const KeymapKey &key : {key_a, key_b, KeymapKey(1, 0, 0, KC_C), KeymapKey(1, 1, 0, KC_D)}) {
+        keymap.push_back(key);
+    }
+    layer_resolution_cache_invalidate(key_a.position);
+
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+    EXPECT_EQ(layer_switch_get_layer(key_b.position), 0);
+}
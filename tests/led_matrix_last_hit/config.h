@@ -0,0 +1,16 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// One LED under every key of the first row of the 4x10 test matrix
+#define LED_MATRIX_LED_COUNT 10
+#define LED_MATRIX_KEYPRESSES
+// Render the frames back to back
+#define LED_MATRIX_LED_FLUSH_LIMIT 0
+// Small enough to overflow with a few key hits
+#define LED_HITS_TO_REMEMBER 4
+
+#define ENABLE_LED_MATRIX_SOLID_REACTIVE_SIMPLE
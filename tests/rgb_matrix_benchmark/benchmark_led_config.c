@@ -0,0 +1,46 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "rgb_matrix.h"
+
+uint32_t benchmark_flush_count = 0;
+
+static void benchmark_init(void) {}
+
+static void benchmark_flush(void) {
+    benchmark_flush_count++;
+}
+
+static void benchmark_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {}
+
+static void benchmark_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = benchmark_init,
+    .flush         = benchmark_flush,
+    .set_color     = benchmark_set_color,
+    .set_color_all = benchmark_set_color_all,
+};
+
+// clang-format off
+led_config_t g_led_config = {
+    {
+        {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9 },
+        { 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 },
+        { 20, 21, 22, 23, 24, 25, 26, 27, 28, 29 },
+        { 30, 31, 32, 33, 34, 35, 36, 37, 38, 39 },
+    },
+    {
+        {   0,  0 }, {  24,  0 }, {  48,  0 }, {  72,  0 }, {  96,  0 }, { 120,  0 }, { 144,  0 }, { 168,  0 }, { 192,  0 }, { 216,  0 },
+        {   4, 21 }, {  28, 21 }, {  52, 21 }, {  76, 21 }, { 100, 21 }, { 124, 21 }, { 148, 21 }, { 172, 21 }, { 196, 21 }, { 220, 21 },
+        {   8, 43 }, {  32, 43 }, {  56, 43 }, {  80, 43 }, { 104, 43 }, { 128, 43 }, { 152, 43 }, { 176, 43 }, { 200, 43 }, { 224, 43 },
+        {  12, 64 }, {  36, 64 }, {  60, 64 }, {  84, 64 }, { 108, 64 }, { 132, 64 }, { 156, 64 }, { 180, 64 }, { 204, 64 }, { 224, 64 },
+    },
+    {
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    }
+};
+// clang-format on
@@ -0,0 +1,51 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "benchmark.hpp"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+extern uint32_t benchmark_flush_count;
+void            advance_time(uint32_t ms);
+}
+
+namespace {
+const char *effect_names[] = {
+    "NONE",
+#define RGB_MATRIX_EFFECT(name, ...) #name,
+#include "rgb_matrix_effects.inc"
+#undef RGB_MATRIX_EFFECT
+};
+} // namespace
+
+/**
+ * Host benchmark of every core effect, rendered frame after frame with a key
+ * hit every 50 frames for the reactive effects.
+ *
+ * CPU times are only comparable between runs on the same machine. Run the
+ * uniform_flags variant to see the cost of testing the LED flags per LED.
+ */
+class RgbMatrixBenchmark : public TestFixture {};
+
+TEST_F(RgbMatrixBenchmark, frame_time_per_effect) {
+    TestDriver driver;
+
+    for (uint8_t mode = RGB_MATRIX_NONE + 1; mode < RGB_MATRIX_EFFECT_MAX; mode++) {
+        rgb_matrix_mode_noeeprom(mode);
+
+        double ns = benchmark::ns_per_iteration(BENCHMARK_FRAMES, [](uint64_t frame) {
+            if (frame % 50 == 0) {
+                process_rgb_matrix(frame % MATRIX_ROWS, frame % MATRIX_COLS, true);
+            }
+            benchmark_flush_count = 0;
+            while (benchmark_flush_count == 0) {
+                rgb_matrix_task();
+            }
+            advance_time(1);
+        });
+
+        benchmark::Line() << benchmark::label(effect_names[mode], 28) << " leds: " << RGB_MATRIX_LED_COUNT << " | cpu/frame: " << benchmark::field(ns, 9) << " ns";
+    }
+}
@@ -0,0 +1,9 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+RGB_MATRIX_ENABLE = yes
+RGB_MATRIX_DRIVER = custom
+
+# Runs the benchmark with the LED flags folded into the effect runners
+SRC += tests/rgb_matrix_benchmark/benchmark_led_config.c
+SRC += tests/rgb_matrix_benchmark/test_rgb_matrix_benchmark.cpp
@@ -0,0 +1,40 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "rgb_matrix.h"
+
+uint32_t last_hit_flush_count = 0;
+
+static void last_hit_init(void) {}
+
+static void last_hit_flush(void) {
+    last_hit_flush_count++;
+}
+
+static void last_hit_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {}
+
+static void last_hit_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = last_hit_init,
+    .flush         = last_hit_flush,
+    .set_color     = last_hit_set_color,
+    .set_color_all = last_hit_set_color_all,
+};
+
+// clang-format off
+led_config_t g_led_config = {
+    {
+        {      0,      1,      2,      3,      4,      5,      6,      7,      8,      9 },
+        { NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED },
+        { NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED },
+        { NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED },
+    },
+    {
+        {   0,  0 }, {  24,  8 }, {  48, 16 }, {  72, 24 }, {  96, 32 }, { 120, 40 }, { 144, 48 }, { 168, 56 }, { 192, 64 }, { 216, 64 },
+    },
+    {
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    }
+};
+// clang-format on
@@ -0,0 +1,104 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+extern uint32_t last_hit_flush_count;
+void            advance_time(uint32_t ms);
+}
+
+class RgbMatrixLastHit : public TestFixture {
+   public:
+    void SetUp() override {
+        rgb_matrix_init();
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_REACTIVE_SIMPLE);
+    }
+
+    void hit(uint8_t col) {
+        process_rgb_matrix(0, col, true);
+        process_rgb_matrix(0, col, false);
+    }
+
+    void render_frame() {
+        last_hit_flush_count = 0;
+        while (last_hit_flush_count == 0) {
+            rgb_matrix_task();
+        }
+    }
+
+    void expect_hits(std::vector<uint8_t> index, std::vector<uint16_t> tick) {
+        ASSERT_EQ(g_last_hit_tracker.count, index.size());
+        for (uint8_t i = 0; i < index.size(); i++) {
+            EXPECT_EQ(g_last_hit_tracker.index[i], index[i]) << "hit " << +i;
+            EXPECT_EQ(g_last_hit_tracker.tick[i], tick[i]) << "hit " << +i;
+            EXPECT_EQ(g_last_hit_tracker.x[i], g_led_config.point[index[i]].x) << "hit " << +i;
+            EXPECT_EQ(g_last_hit_tracker.y[i], g_led_config.point[index[i]].y) << "hit " << +i;
+        }
+    }
+};
+
+TEST_F(RgbMatrixLastHit, HitsAreOldestFirst) {
+    TestDriver driver;
+
+    for (uint8_t col = 0; col < 3; col++) {
+        hit(col);
+        advance_time(10);
+    }
+    render_frame();
+
+    expect_hits({0, 1, 2}, {30, 20, 10});
+}
+
+TEST_F(RgbMatrixLastHit, OldestHitIsOverwrittenWhenFull) {
+    TestDriver driver;
+
+    for (uint8_t col = 0; col < LED_HITS_TO_REMEMBER + 2; col++) {
+        hit(col);
+        advance_time(10);
+    }
+    render_frame();
+
+    expect_hits({2, 3, 4, 5}, {40, 30, 20, 10});
+
+    // Overwriting wraps around the end of the buffer more than once
+    for (uint8_t col = 6; col < 10; col++) {
+        hit(col);
+        advance_time(10);
+    }
+    hit(0);
+    render_frame();
+
+    expect_hits({7, 8, 9, 0}, {30, 20, 10, 0});
+}
+
+TEST_F(RgbMatrixLastHit, HitsOlderThanTickRangeAreDropped) {
+    TestDriver driver;
+
+    hit(0);
+    advance_time(40000);
+    hit(1);
+    advance_time(25535);
+    render_frame();
+
+    // The tick of the first hit is still just in range
+    expect_hits({0, 1}, {65535, 25535});
+
+    advance_time(1);
+    render_frame();
+
+    expect_hits({1}, {25536});
+
+    advance_time(40000);
+    hit(2);
+    render_frame();
+
+    expect_hits({2}, {0});
+
+    advance_time(65536);
+    render_frame();
+
+    expect_hits({}, {});
+}
@@ -0,0 +1,15 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define DYNAMIC_MACRO_DELAY 10
+// Room for VIA macros longer than the send string buffer
+#define EEPROM_SIZE 1024
+#define DYNAMIC_MACRO_NONBLOCKING
+#define SEND_STRING_NONBLOCKING
+// Small enough for the tests to fill them
+#define SEND_STRING_QUEUE_SIZE 4
+#define SEND_STRING_BUFFER_SIZE 16
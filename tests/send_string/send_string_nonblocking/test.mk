@@ -0,0 +1,9 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+SEND_STRING_ENABLE = yes
+DYNAMIC_MACRO_ENABLE = yes
+DYNAMIC_KEYMAP_ENABLE = yes
+
+# The send string tests must pass the same when played back from the queue
+SRC += tests/send_string/test_send_string.cpp
@@ -0,0 +1,265 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+class SendStringNonblocking : public TestFixture {};
+
+TEST_F(SendStringNonblocking, returns_before_typing) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_NO_REPORT(driver);
+    SEND_STRING("ab");
+    EXPECT_TRUE(send_string_is_busy());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    EXPECT_FALSE(send_string_is_busy());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringNonblocking, keys_are_held_until_string_is_sent) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_x(0, 0, 0, KC_X);
+    set_keymap({key_x});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    SEND_STRING("a" SS_DELAY(500) "b");
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The key is scanned while the string is waiting, but not typed yet
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_x);
+    EXPECT_TRUE(send_string_is_busy());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_X));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(500);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringNonblocking, long_string_does_not_block) {
+    TestDriver driver;
+    InSequence s;
+
+    // Longer than the buffer for strings in RAM, the literal isn't copied
+    EXPECT_NO_REPORT(driver);
+    SEND_STRING("abcdefghijklmnopqrstuvwxyz");
+    VERIFY_AND_CLEAR(driver);
+
+    for (uint8_t i = 0; i < 26; i++) {
+        EXPECT_REPORT(driver, (KC_A + i));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    idle_for(10);
+    EXPECT_FALSE(send_string_is_busy());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringNonblocking, string_in_ram_is_copied) {
+    TestDriver driver;
+    InSequence s;
+    char       string[] = "ab";
+
+    EXPECT_NO_REPORT(driver);
+    send_string(string);
+    string[0] = 'c';
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringNonblocking, more_characters_than_queued_strings) {
+    TestDriver driver;
+    InSequence s;
+
+    // Eight characters, sent one by one into a queue of four strings
+    EXPECT_NO_REPORT(driver);
+    send_dword(0xdeadbeef);
+    VERIFY_AND_CLEAR(driver);
+
+    for (char c : {KC_D, KC_E, KC_A, KC_D, KC_B, KC_E, KC_E, KC_F}) {
+        EXPECT_REPORT(driver, (c));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringNonblocking, typed_characters_make_room) {
+    TestDriver driver;
+    InSequence s;
+
+    for (uint8_t i = 0; i < 20; i++) {
+        EXPECT_REPORT(driver, (KC_A + i));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    send_string_with_delay("abcdefghij", 5);
+    // Only fits once the first characters have been typed
+    idle_for(6 * 2 * 5);
+    send_string("klmnopqrst");
+    idle_for(200);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringNonblocking, string_that_does_not_fit_is_typed_right_away) {
+    TestDriver driver;
+    InSequence s;
+    char       string[SEND_STRING_BUFFER_SIZE + 1];
+
+    for (uint8_t i = 0; i < SEND_STRING_BUFFER_SIZE; i++) {
+        string[i] = 'a' + i;
+        EXPECT_REPORT(driver, (KC_A + i));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    string[SEND_STRING_BUFFER_SIZE] = '\0';
+
+    send_string(string);
+    EXPECT_FALSE(send_string_is_busy());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringNonblocking, long_via_macro_is_typed_completely) {
+    TestDriver driver;
+    InSequence s;
+    // Sent in short parts, which only fit in the buffer once the ones before have been typed
+    char macro[4 * SEND_STRING_BUFFER_SIZE + 1];
+
+    for (uint8_t i = 0; i < sizeof(macro) - 1; i++) {
+        macro[i] = 'a' + i % 26;
+        EXPECT_REPORT(driver, (KC_A + i % 26));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    macro[sizeof(macro) - 1] = '\0';
+    dynamic_keymap_macro_set_buffer(0, sizeof(macro), (uint8_t *)macro);
+
+    dynamic_keymap_macro_send(0);
+    idle_for(10);
+    EXPECT_FALSE(send_string_is_busy());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringNonblocking, flush_plays_everything) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    SEND_STRING("a" SS_DELAY(1000) "b");
+    send_string_flush();
+    EXPECT_FALSE(send_string_is_busy());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringNonblocking, dynamic_macro_plays_one_record_per_delay) {
+    TestDriver driver;
+    KeymapKey  key_record(0, 0, 0, DM_REC1);
+    KeymapKey  key_stop(0, 1, 0, DM_RSTP);
+    KeymapKey  key_play(0, 2, 0, DM_PLY1);
+    KeymapKey  key_a(0, 3, 0, KC_A);
+    KeymapKey  key_x(0, 4, 0, KC_X);
+    set_keymap({key_record, key_stop, key_play, key_a, key_x});
+
+    EXPECT_REPORT(driver, (KC_A)).Times(2);
+    EXPECT_EMPTY_REPORT(driver).Times(2);
+    tap_key(key_record);
+    tap_key(key_a);
+    tap_key(key_a);
+    tap_key(key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    // The first record is played right away, the others one delay apart
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_A));
+    tap_key(key_play);
+    EXPECT_TRUE(dynamic_macro_is_playing());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(DYNAMIC_MACRO_DELAY);
+    VERIFY_AND_CLEAR(driver);
+
+    // Other keys are held until the playback has ended
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_x);
+    EXPECT_TRUE(dynamic_macro_is_playing());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_X));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(3 * DYNAMIC_MACRO_DELAY);
+    EXPECT_FALSE(dynamic_macro_is_playing());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringNonblocking, dynamic_macro_played_again_during_playback) {
+    TestDriver driver;
+    KeymapKey  key_record(0, 0, 0, DM_REC1);
+    KeymapKey  key_stop(0, 1, 0, DM_RSTP);
+    KeymapKey  key_play(0, 2, 0, DM_PLY1);
+    KeymapKey  key_a(0, 3, 0, KC_A);
+    KeymapKey  key_layer(0, 4, 0, MO(1));
+    KeymapKey  key_play_layer(1, 2, 0, KC_TRNS);
+    KeymapKey  key_b(1, 3, 0, KC_B);
+    set_keymap({key_record, key_stop, key_play, key_a, key_layer, key_play_layer, key_b});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_record);
+    tap_key(key_a);
+    tap_key(key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    // The second play waits for the first playback, and both restore the layer
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    key_layer.press();
+    run_one_scan_loop();
+    tap_key(key_play);
+    tap_key(key_play);
+    idle_for(10 * DYNAMIC_MACRO_DELAY);
+    EXPECT_FALSE(dynamic_macro_is_playing());
+    EXPECT_TRUE(layer_state_is(1));
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_b);
+    key_layer.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
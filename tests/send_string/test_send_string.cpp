@@ -0,0 +1,100 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class SendString : public TestFixture {};
+
+TEST_F(SendString, types_characters) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_B));
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_1));
+    EXPECT_EMPTY_REPORT(driver);
+    SEND_STRING("aB1");
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendString, types_key_codes) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_LCTL));
+    EXPECT_REPORT(driver, (KC_LCTL, KC_C));
+    EXPECT_REPORT(driver, (KC_LCTL));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_ENT));
+    EXPECT_EMPTY_REPORT(driver);
+    SEND_STRING(SS_DOWN(X_LCTL) SS_TAP(X_C) SS_UP(X_LCTL) SS_TAP(X_ENT));
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendString, waits_for_delays_and_interval) {
+    TestDriver driver;
+    InSequence s;
+    uint32_t   a_time = 0, b_time = 0, c_time = 0;
+
+    EXPECT_REPORT(driver, (KC_A)).WillOnce([&](report_keyboard_t&) { a_time = timer_read32(); });
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B)).WillOnce([&](report_keyboard_t&) { b_time = timer_read32(); });
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_C)).WillOnce([&](report_keyboard_t&) { c_time = timer_read32(); });
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_with_delay("a" SS_DELAY(100) "bc", 5);
+    idle_for(200);
+    VERIFY_AND_CLEAR(driver);
+
+    // Every character is tapped for an interval, and followed by another
+    EXPECT_GE(b_time - a_time, 100u + 3 * 5);
+    EXPECT_GE(c_time - b_time, 2u * 5);
+}
+
+TEST_F(SendString, dynamic_macro_plays_recorded_keys) {
+    TestDriver driver;
+    KeymapKey  key_record(0, 0, 0, DM_REC1);
+    KeymapKey  key_stop(0, 1, 0, DM_RSTP);
+    KeymapKey  key_play(0, 2, 0, DM_PLY1);
+    KeymapKey  key_a(0, 3, 0, KC_A);
+    KeymapKey  key_b(0, 4, 0, KC_B);
+    set_keymap({key_record, key_stop, key_play, key_a, key_b});
+
+    EXPECT_REPORT(driver, (KC_A)).Times(1);
+    EXPECT_REPORT(driver, (KC_A, KC_B)).Times(1);
+    EXPECT_REPORT(driver, (KC_B)).Times(1);
+    EXPECT_EMPTY_REPORT(driver).Times(1);
+    tap_key(key_record);
+    key_a.press();
+    run_one_scan_loop();
+    key_b.press();
+    run_one_scan_loop();
+    key_a.release();
+    run_one_scan_loop();
+    key_b.release();
+    run_one_scan_loop();
+    tap_key(key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_play);
+    idle_for(10 * DYNAMIC_MACRO_DELAY);
+    VERIFY_AND_CLEAR(driver);
+}
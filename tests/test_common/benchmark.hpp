@@ -0,0 +1,126 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * Helpers shared by the host benchmarks, header only so that the unit tests
+ * can use them without linking test_common.
+ *
+ * Host times are wall clock times and only comparable between runs on the
+ * same machine.
+ */
+namespace benchmark {
+
+/**
+ * Returns the host time taken by fn(), in nanoseconds.
+ */
+template <typename F>
+uint64_t time_ns(F&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+/**
+ * Calls fn(i) for every i below count and returns the mean host time per
+ * call, in nanoseconds.
+ */
+template <typename F>
+double ns_per_iteration(uint64_t count, F&& fn) {
+    uint64_t ns = time_ns([&]() {
+        for (uint64_t i = 0; i < count; i++) {
+            fn(i);
+        }
+    });
+    return count ? (double)ns / count : 0.0;
+}
+
+template <typename T>
+T percentile(std::vector<T> samples, unsigned pct) {
+    if (samples.empty()) {
+        return 0;
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[(samples.size() - 1) * pct / 100];
+}
+
+template <typename T>
+double mean(const std::vector<T>& samples) {
+    if (samples.empty()) {
+        return 0;
+    }
+    return std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+}
+
+template <typename T>
+struct Field {
+    T    value;
+    int  width;
+    int  precision;
+    bool left;
+};
+
+/**
+ * A right aligned column of the given width, floating point values are
+ * printed with the given number of decimals.
+ */
+template <typename T>
+Field<T> field(T value, int width, int precision = 1) {
+    return {value, width, precision, false};
+}
+
+/**
+ * A left aligned column of the given width, for names.
+ */
+inline Field<std::string> label(const std::string& text, int width) {
+    return {text, width, 1, true};
+}
+
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const Field<T>& f) {
+    std::streamsize precision = os.precision(f.precision);
+    os << (f.left ? std::left : std::right) << std::setw(f.width) << f.value << std::right;
+    os.precision(precision);
+    return os;
+}
+
+/**
+ * Prints one result line in the style of the gtest output around it:
+ *
+ *     benchmark::Line() << benchmark::label(name, 14) << " cpu/frame: " << benchmark::field(ns, 9) << " ns";
+ *
+ * The line is printed when the temporary goes out of scope.
+ */
+class Line {
+   public:
+    Line() {
+        m_line << "[ BENCH    ] " << std::fixed << std::setprecision(1);
+    }
+
+    ~Line() {
+        std::cout << m_line.str() << std::endl;
+    }
+
+    template <typename T>
+    Line& operator<<(const T& value) {
+        m_line << value;
+        return *this;
+    }
+
+   private:
+    std::ostringstream m_line;
+};
+
+} // namespace benchmark
@@ -133,6 +133,14 @@ static void dummy_usb_cb(USBDriver *usbp, usbep_t ep) {
     (void)ep;
 }
 
+#ifdef USB_REPORT_QUEUE_ENABLE
+/* Report endpoints drain their queue whenever a transfer completes. */
+static void usb_report_transmitted_cb(USBDriver *usbp, usbep_t ep);
+#    define REPORT_IN_CB usb_report_transmitted_cb
+#else
+#    define REPORT_IN_CB dummy_usb_cb
+#endif
+
 #ifndef KEYBOARD_SHARED_EP
 /* keyboard endpoint state structure */
 static USBInEndpointState kbd_ep_state;
@@ -140,7 +148,7 @@ static USBInEndpointState kbd_ep_state;
 static const USBEndpointConfig kbd_ep_config = {
     USB_EP_MODE_TYPE_INTR,  /* Interrupt EP */
     NULL,                   /* SETUP packet notification callback */
-    dummy_usb_cb,           /* IN notification callback */
+    REPORT_IN_CB,           /* IN notification callback */
     NULL,                   /* OUT notification callback */
     KEYBOARD_EPSIZE,        /* IN maximum packet size */
     0,                      /* OUT maximum packet size */
@@ -158,7 +166,7 @@ static USBInEndpointState mouse_ep_state;
 static const USBEndpointConfig mouse_ep_config = {
     USB_EP_MODE_TYPE_INTR,  /* Interrupt EP */
     NULL,                   /* SETUP packet notification callback */
-    dummy_usb_cb,           /* IN notification callback */
+    REPORT_IN_CB,           /* IN notification callback */
     NULL,                   /* OUT notification callback */
     MOUSE_EPSIZE,           /* IN maximum packet size */
     0,                      /* OUT maximum packet size */
@@ -176,7 +184,7 @@ static USBInEndpointState shared_ep_state;
 static const USBEndpointConfig shared_ep_config = {
     USB_EP_MODE_TYPE_INTR,  /* Interrupt EP */
     NULL,                   /* SETUP packet notification callback */
-    dummy_usb_cb,           /* IN notification callback */
+    REPORT_IN_CB,           /* IN notification callback */
     NULL,                   /* OUT notification callback */
     SHARED_EPSIZE,          /* IN maximum packet size */
     0,                      /* OUT maximum packet size */
@@ -194,7 +202,7 @@ static USBInEndpointState joystick_ep_state;
 static const USBEndpointConfig joystick_ep_config = {
     USB_EP_MODE_TYPE_INTR,  /* Interrupt EP */
     NULL,                   /* SETUP packet notification callback */
-    dummy_usb_cb,           /* IN notification callback */
+    REPORT_IN_CB,           /* IN notification callback */
     NULL,                   /* OUT notification callback */
     JOYSTICK_EPSIZE,        /* IN maximum packet size */
     0,                      /* OUT maximum packet size */
@@ -212,7 +220,7 @@ static USBInEndpointState digitizer_ep_state;
 static const USBEndpointConfig digitizer_ep_config = {
     USB_EP_MODE_TYPE_INTR,  /* Interrupt EP */
     NULL,                   /* SETUP packet notification callback */
-    dummy_usb_cb,           /* IN notification callback */
+    REPORT_IN_CB,           /* IN notification callback */
     NULL,                   /* OUT notification callback */
     DIGITIZER_EPSIZE,       /* IN maximum packet size */
     0,                      /* OUT maximum packet size */
@@ -507,6 +515,9 @@ static void usb_event_cb(USBDriver *usbp, usbevent_t event) {
 
         case USB_EVENT_CONFIGURED:
             osalSysLockFromISR();
+#ifdef USB_REPORT_QUEUE_ENABLE
+            usb_report_queue_resetI();
+#endif
             /* Enable the endpoints specified into the configuration. */
 #ifndef KEYBOARD_SHARED_EP
             usbInitEndpointI(usbp, KEYBOARD_IN_EPNUM, &kbd_ep_config);
@@ -842,6 +853,115 @@ uint8_t keyboard_leds(void) {
     return keyboard_led_state;
 }
 
+#ifdef USB_REPORT_QUEUE_ENABLE
+/* ---------------------------------------------------------
+ *                     Report queue
+ * ---------------------------------------------------------
+ */
+
+#    include "usb_report_queue.h"
+
+#    ifndef KEYBOARD_SHARED_EP
+USB_REPORT_QUEUE(kbd, KEYBOARD_EPSIZE, false);
+#    endif
+#    if defined(MOUSE_ENABLE) && !defined(MOUSE_SHARED_EP)
+USB_REPORT_QUEUE(mouse, MOUSE_EPSIZE, false);
+#    endif
+#    ifdef SHARED_EP_ENABLE
+USB_REPORT_QUEUE(shared, SHARED_EPSIZE, true);
+#    endif
+#    if defined(JOYSTICK_ENABLE) && !defined(JOYSTICK_SHARED_EP)
+USB_REPORT_QUEUE(joystick, JOYSTICK_EPSIZE, false);
+#    endif
+#    if defined(DIGITIZER_ENABLE) && !defined(DIGITIZER_SHARED_EP)
+USB_REPORT_QUEUE(digitizer, DIGITIZER_EPSIZE, false);
+#    endif
+
+static usb_report_queue_t *usb_report_queue_get(uint8_t endpoint) {
+#    ifndef KEYBOARD_SHARED_EP
+    if (endpoint == KEYBOARD_IN_EPNUM) {
+        return &kbd_report_queue;
+    }
+#    endif
+#    if defined(MOUSE_ENABLE) && !defined(MOUSE_SHARED_EP)
+    if (endpoint == MOUSE_IN_EPNUM) {
+        return &mouse_report_queue;
+    }
+#    endif
+#    ifdef SHARED_EP_ENABLE
+    if (endpoint == SHARED_IN_EPNUM) {
+        return &shared_report_queue;
+    }
+#    endif
+#    if defined(JOYSTICK_ENABLE) && !defined(JOYSTICK_SHARED_EP)
+    if (endpoint == JOYSTICK_IN_EPNUM) {
+        return &joystick_report_queue;
+    }
+#    endif
+#    if defined(DIGITIZER_ENABLE) && !defined(DIGITIZER_SHARED_EP)
+    if (endpoint == DIGITIZER_IN_EPNUM) {
+        return &digitizer_report_queue;
+    }
+#    endif
+    return NULL;
+}
+
+/* Starts transmitting the head of the queue, unless the endpoint is busy. */
+static void usb_report_queue_kickI(USBDriver *usbp, usbep_t ep, usb_report_queue_t *queue) {
+    if (usbGetTransmitStatusI(usbp, ep)) {
+        return;
+    }
+    uint8_t        size;
+    const uint8_t *report = usb_report_queue_start(queue, &size);
+    if (report != NULL) {
+        usbStartTransmitI(usbp, ep, report, size);
+    }
+}
+
+/* IN complete callback (called from ISR, unlocked state) */
+static void usb_report_transmitted_cb(USBDriver *usbp, usbep_t ep) {
+    usb_report_queue_t *queue = usb_report_queue_get(ep);
+    if (queue == NULL) {
+        return;
+    }
+
+    osalSysLockFromISR();
+    usb_report_queue_transmitted(queue);
+    usb_report_queue_kickI(usbp, ep, queue);
+    osalSysUnlockFromISR();
+}
+
+/* Drops everything queued, the endpoints are reinitialised after this. */
+static void usb_report_queue_resetI(void) {
+    for (uint8_t ep = 1; ep <= USB_MAX_ENDPOINTS; ep++) {
+        usb_report_queue_t *queue = usb_report_queue_get(ep);
+        if (queue != NULL) {
+            usb_report_queue_reset(queue);
+        }
+    }
+}
+
+static void usb_report_queue_send(uint8_t endpoint, const void *report, size_t size, usb_report_merge_t merge) {
+    usb_report_queue_t *queue = usb_report_queue_get(endpoint);
+    if (queue == NULL) {
+        return;
+    }
+
+    osalSysLock();
+    if (usbGetDriverStateI(&USB_DRIVER) != USB_ACTIVE) {
+        osalSysUnlock();
+        return;
+    }
+
+    usb_report_queue_push(queue, report, size, merge);
+    usb_report_queue_kickI(&USB_DRIVER, endpoint, queue);
+    osalSysUnlock();
+}
+
+void send_report(uint8_t endpoint, void *report, size_t size) {
+    usb_report_queue_send(endpoint, report, size, NULL);
+}
+#else
 void send_report(uint8_t endpoint, void *report, size_t size) {
     osalSysLock();
     if (usbGetDriverStateI(&USB_DRIVER) != USB_ACTIVE) {
@@ -862,6 +982,7 @@ void send_report(uint8_t endpoint, void *report, size_t size) {
     usbStartTransmitI(&USB_DRIVER, endpoint, report, size);
     osalSysUnlock();
 }
+#endif
 
 /* prepare and start sending a report IN
  * not callable from ISR or locked state */
@@ -889,7 +1010,11 @@ void send_nkro(report_nkro_t *report) {
 
 void send_mouse(report_mouse_t *report) {
 #ifdef MOUSE_ENABLE
+#    ifdef USB_REPORT_QUEUE_ENABLE
+    usb_report_queue_send(MOUSE_IN_EPNUM, report, sizeof(report_mouse_t), usb_report_merge_mouse);
+#    else
     send_report(MOUSE_IN_EPNUM, report, sizeof(report_mouse_t));
+#    endif
     mouse_report_sent = *report;
 #endif
 }
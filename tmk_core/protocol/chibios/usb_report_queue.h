@@ -0,0 +1,166 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "report.h"
+
+/* Reports are copied into a small per-endpoint queue instead of waiting for
+ * the endpoint to become free, so keyboard_task() never blocks on the host.
+ * The head of the queue is the report being transmitted, the IN complete
+ * callback pops it and starts the next one.
+ *
+ * Reports stay in order so that a short tap is never lost. If the queue is
+ * full, the newest report replaces the last queued report of the same kind,
+ * as that holds the latest state. On endpoints shared by several report IDs
+ * reports of the same kind have the same ID and size, a report is dropped
+ * rather than replacing one of another kind, so that a queued release of
+ * another kind still reaches the host. Mouse movement is summed into the last
+ * queued mouse report as long as the buttons didn't change.
+ *
+ * None of these functions lock, the caller has to hold the system lock. */
+
+#ifndef USB_REPORT_QUEUE_SIZE
+#    define USB_REPORT_QUEUE_SIZE 4
+#endif
+
+typedef bool (*usb_report_merge_t)(void *queued, const void *report);
+
+typedef struct {
+    uint8_t *buffer;
+    uint8_t  slot_size;
+    uint8_t  sizes[USB_REPORT_QUEUE_SIZE];
+    uint8_t  head;
+    uint8_t  count;
+    bool     in_flight;
+    bool     report_ids;
+} usb_report_queue_t;
+
+/* report_ids is set for endpoints whose reports start with a report ID */
+#define USB_REPORT_QUEUE(name, epsize, ids)                                                                    \
+    static uint8_t            name##_report_buffer[USB_REPORT_QUEUE_SIZE][epsize] __attribute__((aligned(4))); \
+    static usb_report_queue_t name##_report_queue = {.buffer = &name##_report_buffer[0][0], .slot_size = epsize, .report_ids = ids}
+
+static inline uint8_t *usb_report_queue_slot(usb_report_queue_t *queue, uint8_t index) {
+    return &queue->buffer[(index % USB_REPORT_QUEUE_SIZE) * queue->slot_size];
+}
+
+static inline bool usb_report_queue_same_kind(usb_report_queue_t *queue, uint8_t index, const void *report, size_t size) {
+    return queue->sizes[index % USB_REPORT_QUEUE_SIZE] == size && (!queue->report_ids || usb_report_queue_slot(queue, index)[0] == ((const uint8_t *)report)[0]);
+}
+
+/**
+ * @brief Adds a report to the queue, merging it into the last queued report
+ * if merge is given and agrees.
+ */
+static inline void usb_report_queue_push(usb_report_queue_t *queue, const void *report, size_t size, usb_report_merge_t merge) {
+    if (size > queue->slot_size) {
+        return;
+    }
+
+    /* Queued reports can still be changed if they aren't being sent yet */
+    uint8_t first_writable = queue->in_flight ? 1 : 0;
+    uint8_t tail           = (queue->head + queue->count - 1) % USB_REPORT_QUEUE_SIZE;
+
+    if (queue->count > first_writable && merge && usb_report_queue_same_kind(queue, tail, report, size) && merge(usb_report_queue_slot(queue, tail), report)) {
+        return;
+    }
+
+    if (queue->count < USB_REPORT_QUEUE_SIZE) {
+        uint8_t next = (queue->head + queue->count) % USB_REPORT_QUEUE_SIZE;
+        memcpy(usb_report_queue_slot(queue, next), report, size);
+        queue->sizes[next] = size;
+        queue->count++;
+        return;
+    }
+
+    for (uint8_t i = queue->count; i-- > first_writable;) {
+        uint8_t index = (queue->head + i) % USB_REPORT_QUEUE_SIZE;
+        if (usb_report_queue_same_kind(queue, index, report, size)) {
+            memcpy(usb_report_queue_slot(queue, index), report, size);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Returns the report to transmit next and marks it in flight, or NULL
+ * if a report is already in flight or the queue is empty.
+ */
+static inline const uint8_t *usb_report_queue_start(usb_report_queue_t *queue, uint8_t *size) {
+    if (queue->in_flight || queue->count == 0) {
+        return NULL;
+    }
+    queue->in_flight = true;
+    *size            = queue->sizes[queue->head];
+    return usb_report_queue_slot(queue, queue->head);
+}
+
+/**
+ * @brief Drops the report in flight once it has been transmitted.
+ */
+static inline void usb_report_queue_transmitted(usb_report_queue_t *queue) {
+    /* The idle timer also sends reports, those aren't in the queue */
+    if (queue->in_flight) {
+        queue->in_flight = false;
+        queue->head      = (queue->head + 1) % USB_REPORT_QUEUE_SIZE;
+        queue->count--;
+    }
+}
+
+static inline void usb_report_queue_reset(usb_report_queue_t *queue) {
+    queue->head      = 0;
+    queue->count     = 0;
+    queue->in_flight = false;
+}
+
+static inline bool usb_report_add_checked(int32_t a, int32_t b, int32_t min, int32_t max, int32_t *sum) {
+    *sum = a + b;
+    return *sum >= min && *sum <= max;
+}
+
+/**
+ * @brief Sums the movement of two mouse reports, as long as nothing overflows
+ * and the buttons are the same.
+ */
+static inline bool usb_report_merge_mouse(void *queued, const void *report) {
+    report_mouse_t *      q = (report_mouse_t *)queued;
+    const report_mouse_t *r = (const report_mouse_t *)report;
+    int32_t               x, y, v, h;
+
+#ifdef MOUSE_SHARED_EP
+    if (q->report_id != r->report_id) {
+        return false;
+    }
+#endif
+    if (q->buttons != r->buttons) {
+        return false;
+    }
+#ifdef MOUSE_EXTENDED_REPORT
+    if (!usb_report_add_checked(q->x, r->x, INT16_MIN, INT16_MAX, &x) || !usb_report_add_checked(q->y, r->y, INT16_MIN, INT16_MAX, &y)) {
+        return false;
+    }
+#else
+    if (!usb_report_add_checked(q->x, r->x, INT8_MIN, INT8_MAX, &x) || !usb_report_add_checked(q->y, r->y, INT8_MIN, INT8_MAX, &y)) {
+        return false;
+    }
+#endif
+    if (!usb_report_add_checked(q->v, r->v, INT8_MIN, INT8_MAX, &v) || !usb_report_add_checked(q->h, r->h, INT8_MIN, INT8_MAX, &h)) {
+        return false;
+    }
+
+    q->x = x;
+    q->y = y;
+    q->v = v;
+    q->h = h;
+#ifdef MOUSE_EXTENDED_REPORT
+    // clip and copy to Boot protocol XY, the same way as host_mouse_send()
+    q->boot_x = (x > 127) ? 127 : ((x < -127) ? -127 : x);
+    q->boot_y = (y > 127) ? 127 : ((y < -127) ? -127 : y);
+#endif
+    return true;
+}